@@ -0,0 +1,22 @@
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+#if ARDUINOJSON_HAS_STRING_TEMPLATE_ARGS
+TEST_CASE("C++20 StaticFilter") {
+  using namespace DeserializationOption;
+  using MyFilter = StaticFilter<Key<"temp">, Key<"sensors", Each<Key<"id">>>>;
+
+  JsonDocument doc;
+  DeserializationError err = deserializeJson(
+      doc,
+      "{\"temp\":21.5,\"hum\":40,\"sensors\":[{\"id\":1,\"v\":2},{\"id\":3}],"
+      "\"log\":[1,2]}",
+      MyFilter());
+
+  REQUIRE(err == DeserializationError::Ok);
+  REQUIRE(doc.as<std::string>() ==
+          "{\"temp\":21.5,\"sensors\":[{\"id\":1},{\"id\":3}]}");
+}
+#endif
@@ -0,0 +1,12 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+// CopyFromInput is only supported by deserializeJson()
+
+int main() {
+  JsonDocument doc;
+  deserializeMsgPack(doc, "\x91\x2A", DeserializationOption::CopyFromInput);
+}
@@ -0,0 +1,13 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+// InSitu is only supported by deserializeJson()
+
+int main() {
+  JsonDocument doc;
+  char input[] = "\x91\x2A";
+  deserializeMsgPack(doc, input, DeserializationOption::InSitu);
+}
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/CollectionIndex.hpp>
 #include <ArduinoJson/Memory/MemoryPool.hpp>
 #include <ArduinoJson/Memory/StringBuilder.hpp>
 
@@ -275,6 +276,12 @@ inline size_t sizeofPool(
   return MemoryPool<VariantData>::slotsToBytes(n);
 }
 
+inline size_t sizeofStringChunk(
+    size_t capacity = ArduinoJson::detail::StringArena::initialChunkSize) {
+  using namespace ArduinoJson::detail;
+  return StringArena::sizeofChunk(addPadding(capacity));
+}
+
 inline size_t sizeofStringBuffer(size_t iteration = 1) {
   // returns 31, 63, 127, 255, etc.
   auto capacity = ArduinoJson::detail::StringBuilder::initialCapacity;
@@ -286,3 +293,29 @@ inline size_t sizeofStringBuffer(size_t iteration = 1) {
 inline size_t sizeofString(const char* s) {
   return ArduinoJson::detail::sizeofString(strlen(s));
 }
+
+#if ARDUINOJSON_USE_COLLECTION_INDEX
+inline size_t sizeofIndexMap() {
+  return ArduinoJson::detail::CollectionIndexMap::sizeofEntries();
+}
+
+inline size_t sizeofArrayIndex(size_t iteration = 1) {
+  // returns the size for 17, 34, 68, 136, etc. elements
+  size_t capacity = 17;
+  for (size_t i = 1; i < iteration; i++)
+    capacity *= 2;
+  return capacity * sizeof(ArduinoJson::detail::SlotId);
+}
+
+// The reallocations of the index of an array, between two sizes returned by
+// sizeofArrayIndex(); 0 means that the array has no index
+inline AllocatorLogEntry GrowArrayIndex(size_t from, size_t to) {
+  std::string s;
+  for (size_t i = from; i < to; i++) {
+    if (i > from)
+      s += "\n";
+    s += Reallocate(i ? sizeofArrayIndex(i) : 0, sizeofArrayIndex(i + 1)).str();
+  }
+  return AllocatorLogEntry(s);
+}
+#endif
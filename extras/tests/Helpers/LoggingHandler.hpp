@@ -0,0 +1,77 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/JsonHandler.hpp>
+
+#include <sstream>
+#include <string>
+
+// Records the calls as a string like "{ key:a [ 1 2 ] }"
+class LoggingHandler : public ArduinoJson::JsonHandler {
+ public:
+  void onStartObject() override {
+    log("{");
+  }
+
+  void onKey(ArduinoJson::JsonString key) override {
+    log("key:" + std::string(key.c_str(), key.size()));
+  }
+
+  void onEndObject() override {
+    log("}");
+  }
+
+  void onStartArray() override {
+    log("[");
+  }
+
+  void onEndArray() override {
+    log("]");
+  }
+
+  void onNull() override {
+    log("null");
+  }
+
+  void onBoolean(bool value) override {
+    log(value ? "true" : "false");
+  }
+
+  void onInteger(ArduinoJson::JsonInteger value) override {
+    log("int:" + std::to_string(value));
+  }
+
+  void onUnsignedInteger(ArduinoJson::JsonUInt value) override {
+    log("uint:" + std::to_string(value));
+  }
+
+  void onFloat(ArduinoJson::JsonFloat value) override {
+    std::ostringstream s;
+    s << "float:" << value;
+    log(s.str());
+  }
+
+  void onString(ArduinoJson::JsonString value) override {
+    log("string:" + std::string(value.c_str(), value.size()));
+  }
+
+  void onRawValue(ArduinoJson::JsonString value) override {
+    log("raw:" + std::to_string(value.size()));
+  }
+
+  const std::string& str() const {
+    return log_;
+  }
+
+ private:
+  void log(const std::string& s) {
+    if (!log_.empty())
+      log_ += ' ';
+    log_ += s;
+  }
+
+  std::string log_;
+};
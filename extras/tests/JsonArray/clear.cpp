@@ -41,6 +41,10 @@ TEST_CASE("JsonArray::clear()") {
 
     REQUIRE(spy.log() == AllocatorLog{
                              Allocate(sizeofPool()),
+                             Allocate(sizeofIndexMap()),
+                             GrowArrayIndex(0, 5),
+                             Deallocate(sizeofArrayIndex(5)),  // clear()
+                             GrowArrayIndex(0, 5),
                          });
   }
 }
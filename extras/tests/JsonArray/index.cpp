@@ -0,0 +1,115 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "Allocators.hpp"
+
+TEST_CASE("JsonArray with many elements") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+  JsonArray array = doc.to<JsonArray>();
+  for (int i = 0; i < 100; i++)
+    array.add(i);
+
+  SECTION("operator[] returns all elements") {
+    for (int i = 0; i < 100; i++)
+      REQUIRE(array[i] == i);
+    REQUIRE(array[100].isNull());
+  }
+
+  SECTION("JsonArrayConst::operator[] returns all elements") {
+    JsonArrayConst carray = array;
+    for (int i = 0; i < 100; i++)
+      REQUIRE(carray[i] == i);
+    REQUIRE(carray[100].isNull());
+  }
+
+  SECTION("reads don't allocate, so threads can share the array") {
+    spy.clearLog();
+    JsonArrayConst carray = array;
+    for (int i = 0; i < 100; i++)
+      REQUIRE(carray[i] == i);
+    REQUIRE(carray[100].isNull());
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("returns elements added after the index was built") {
+    REQUIRE(array[99] == 99);
+    for (int i = 100; i < 200; i++)
+      array.add(i);
+    for (int i = 0; i < 200; i++)
+      REQUIRE(array[i] == i);
+  }
+
+  SECTION("operator[] adds elements past the end") {
+    REQUIRE(array[99] == 99);
+    array[102] = 102;
+    REQUIRE(array.size() == 103);
+    REQUIRE(array[100].isNull());
+    REQUIRE(array[101].isNull());
+    REQUIRE(array[102] == 102);
+  }
+
+  SECTION("remove(index)") {
+    REQUIRE(array[99] == 99);
+
+    SECTION("remove first element") {
+      array.remove(0);
+      REQUIRE(array[0] == 1);
+      REQUIRE(array[98] == 99);
+      REQUIRE(array.size() == 99);
+    }
+
+    SECTION("remove element in the middle") {
+      array.remove(50);
+      REQUIRE(array[49] == 49);
+      REQUIRE(array[50] == 51);
+      REQUIRE(array[98] == 99);
+      REQUIRE(array.size() == 99);
+    }
+
+    SECTION("remove all elements") {
+      for (size_t i = 100; i > 0; i--)
+        array.remove(i - 1);
+      REQUIRE(array.size() == 0);
+      REQUIRE(array[20].isNull());
+    }
+  }
+
+  SECTION("remove(iterator)") {
+    REQUIRE(array[99] == 99);
+    array.remove(array.begin());
+    REQUIRE(array[0] == 1);
+    REQUIRE(array[98] == 99);
+    REQUIRE(array.size() == 99);
+  }
+
+  SECTION("remove(iterator) keeps the index") {
+    auto it = array.begin();
+    for (int i = 0; i < 50; i++)
+      ++it;
+    spy.clearLog();
+
+    array.remove(it);
+    array.add(100);
+
+    REQUIRE(spy.log() == AllocatorLog{});  // the index wasn't released
+    REQUIRE(array.size() == 100);
+    for (int i = 0; i < 50; i++)
+      REQUIRE(array[i] == i);
+    for (int i = 50; i < 100; i++)
+      REQUIRE(array[i] == i + 1);
+  }
+
+  SECTION("clear() releases the index") {
+    REQUIRE(array[99] == 99);
+    array.clear();
+    REQUIRE(array.size() == 0);
+    REQUIRE(array[99].isNull());
+    doc.clear();
+    REQUIRE(spy.allocatedBytes() == 0);
+  }
+}
@@ -85,6 +85,44 @@ TEST_CASE("JsonArray::remove()") {
     REQUIRE(array[1] == 3);
   }
 
+  SECTION("In a loop, removing consecutive elements") {
+    array.add(3);
+    for (JsonArray::iterator it = array.begin(); it != array.end(); ++it) {
+      if (*it == 2 || *it == 3)
+        array.remove(it);
+    }
+
+    REQUIRE(1 == array.size());
+    REQUIRE(array[0] == 1);
+  }
+
+  SECTION("remove() returns the next element") {
+    JsonArray::iterator it = array.begin();
+    ++it;
+    it = array.remove(it);
+
+    REQUIRE(*it == 3);
+    REQUIRE(array.remove(it) == array.end());
+    REQUIRE(1 == array.size());
+  }
+
+  SECTION("In a loop, using the returned iterator") {
+    array.add(2);
+    array.add(4);
+    JsonArray::iterator it = array.begin();
+    while (it != array.end()) {
+      if (*it == 2)
+        it = array.remove(it);
+      else
+        ++it;
+    }
+
+    REQUIRE(3 == array.size());
+    REQUIRE(array[0] == 1);
+    REQUIRE(array[1] == 3);
+    REQUIRE(array[2] == 4);
+  }
+
   SECTION("remove by index on unbound reference") {
     JsonArray unboundArray;
     unboundArray.remove(20);
@@ -92,7 +130,7 @@ TEST_CASE("JsonArray::remove()") {
 
   SECTION("remove by iterator on unbound reference") {
     JsonArray unboundArray;
-    unboundArray.remove(unboundArray.begin());
+    REQUIRE(unboundArray.remove(unboundArray.begin()) == unboundArray.end());
   }
 
   SECTION("use JsonVariant as index") {
@@ -122,5 +160,7 @@ TEST_CASE("Removed elements are recycled") {
 
   REQUIRE(spy.log() == AllocatorLog{
                            Allocate(sizeofPool()),  // only one pool
+                           Allocate(sizeofIndexMap()),
+                           GrowArrayIndex(0, 5),
                        });
 }
@@ -0,0 +1,148 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+
+using ArduinoJson::detail::CompiledFilterEntry;
+using ArduinoJson::detail::CompiledFilterNode;
+
+static void checkSameAsFilter(const char* filterJson, const char* input) {
+  JsonDocument filter;
+  REQUIRE(deserializeJson(filter, filterJson) == DeserializationError::Ok);
+  CompiledFilter compiledFilter(filter);
+
+  JsonDocument expected, actual;
+  DeserializationError expectedErr =
+      deserializeJson(expected, input, DeserializationOption::Filter(filter));
+  DeserializationError actualErr =
+      deserializeJson(actual, input, compiledFilter.filter());
+
+  CAPTURE(filterJson);
+  CAPTURE(input);
+  REQUIRE(actualErr == expectedErr);
+  REQUIRE(actual.as<std::string>() == expected.as<std::string>());
+}
+
+TEST_CASE("CompiledFilter") {
+  SECTION("gives the same result as Filter") {
+    const char* input =
+        "{\"a\":1,\"b\":[1,{\"c\":2}],\"*\":3,\"d\":{\"e\":4,\"f\":5},"
+        "\"0\":[6]}";
+
+    checkSameAsFilter("null", input);
+    checkSameAsFilter("false", input);
+    checkSameAsFilter("true", input);
+    checkSameAsFilter("42", input);
+    checkSameAsFilter("\"a\"", input);
+    checkSameAsFilter("{}", input);
+    checkSameAsFilter("[]", input);
+    checkSameAsFilter("{\"a\":true}", input);
+    checkSameAsFilter("{\"a\":1,\"b\":0}", input);
+    checkSameAsFilter("{\"b\":[{\"c\":true}]}", input);
+    checkSameAsFilter("{\"b\":{\"c\":true}}", input);
+    checkSameAsFilter("{\"b\":{\"*\":true}}", input);
+    checkSameAsFilter("{\"b\":[[true]]}", input);
+    checkSameAsFilter("{\"*\":{\"e\":true}}", input);
+    checkSameAsFilter("{\"*\":{\"e\":true},\"a\":true}", input);
+    checkSameAsFilter("{\"*\":true,\"a\":false}", input);
+    checkSameAsFilter("{\"*\":true,\"a\":null}", input);
+    checkSameAsFilter("{\"a\":null,\"a\":true}", input);
+    checkSameAsFilter("{\"a\":true,\"a\":false}", input);
+    checkSameAsFilter("{\"*\":null,\"*\":true}", input);
+    checkSameAsFilter("{\"d\":{\"*\":false,\"f\":true}}", input);
+    checkSameAsFilter("{\"0\":true}", input);
+    checkSameAsFilter("[true]", "[1,[2],{\"a\":3}]");
+    checkSameAsFilter("[{\"a\":true}]", "[1,[2],{\"a\":3,\"b\":4}]");
+    checkSameAsFilter("{\"*\":true}", "[1,[2],{\"a\":3}]");
+    checkSameAsFilter("{\"a\":true}", "[1,[2],{\"a\":3}]");
+  }
+
+  SECTION("many keys") {
+    JsonDocument filter;
+    for (int i = 0; i < 100; i += 2)
+      filter["key" + std::to_string(i)] = true;
+    CompiledFilter compiledFilter(filter);
+
+    std::string input = "{";
+    for (int i = 0; i < 100; i++) {
+      if (i)
+        input += ",";
+      input += "\"key" + std::to_string(i) + "\":" + std::to_string(i);
+    }
+    input += "}";
+
+    JsonDocument doc;
+    DeserializationError err =
+        deserializeJson(doc, input, compiledFilter.filter());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.size() == 50);
+    for (int i = 0; i < 100; i++) {
+      CAPTURE(i);
+      std::string key = "key" + std::to_string(i);
+      REQUIRE(doc[key].isNull() == (i % 2 == 1));
+    }
+  }
+
+  SECTION("doesn't depend on the filter document") {
+    JsonDocument filter;
+    filter["a"] = true;
+    CompiledFilter compiledFilter(filter);
+    filter.clear();
+
+    JsonDocument doc;
+    deserializeJson(doc, "{\"a\":1,\"b\":2}", compiledFilter.filter());
+
+    REQUIRE(doc.as<std::string>() == "{\"a\":1}");
+  }
+
+  SECTION("move") {
+    JsonDocument filter;
+    filter["a"] = true;
+    CompiledFilter original(filter);
+    CompiledFilter compiledFilter(std::move(original));
+
+    JsonDocument doc;
+    deserializeJson(doc, "{\"a\":1,\"b\":2}", compiledFilter.filter());
+
+    REQUIRE(doc.as<std::string>() == "{\"a\":1}");
+  }
+}
+
+TEST_CASE("CompiledFilter memory") {
+  JsonDocument filter;
+  filter["a"] = true;
+
+  SECTION("uses a single block") {
+    SpyingAllocator spy;
+    size_t blockSize = 2 * sizeof(CompiledFilterNode) +
+                       4 * sizeof(CompiledFilterEntry) + sizeof("a") - 1;
+
+    {
+      CompiledFilter compiledFilter(filter, &spy);
+      REQUIRE(compiledFilter.overflowed() == false);
+    }
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(blockSize),
+                             Deallocate(blockSize),
+                         });
+  }
+
+  SECTION("rejects everything if allocation fails") {
+    TimebombAllocator timebomb(0);
+    CompiledFilter compiledFilter(filter, &timebomb);
+    REQUIRE(compiledFilter.overflowed() == true);
+
+    JsonDocument doc;
+    deserializeJson(doc, "{\"a\":1,\"b\":2}", compiledFilter.filter());
+
+    REQUIRE(doc.isNull());
+  }
+}
@@ -0,0 +1,130 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+#include "Allocators.hpp"
+
+using ArduinoJson::detail::sizeofArray;
+using ArduinoJson::detail::sizeofObject;
+using DeserializationOption::CopyFromInput;
+
+TEST_CASE("deserializeJson(..., CopyFromInput)") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("saves the strings without the StringBuilder") {
+    DeserializationError err =
+        deserializeJson(doc, "{\"hello\":\"world\"}", CopyFromInput);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["hello"] == "world");
+    REQUIRE(spy.log() ==
+            AllocatorLog{
+                Allocate(sizeofPool()),
+                Allocate(sizeofString("hello")),
+                Allocate(sizeofString("world")),
+                Reallocate(sizeofPool(), sizeofObject(1)),
+            });
+  }
+
+  SECTION("deduplicates the strings") {
+    DeserializationError err = deserializeJson(
+        doc, "[{\"example\":1},{\"example\":\"example\"}]", CopyFromInput);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[1]["example"] == "example");
+    REQUIRE(spy.log() ==
+            AllocatorLog{
+                Allocate(sizeofPool()),
+                Allocate(sizeofString("example")),
+                Reallocate(sizeofPool(), sizeofArray(2) + 2 * sizeofObject(1)),
+            });
+  }
+
+  SECTION("unescapes the other strings in the StringBuilder") {
+    DeserializationError err =
+        deserializeJson(doc, "[\"hello\\nworld\"]", CopyFromInput);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == "hello\nworld");
+    REQUIRE(spy.log() ==
+            AllocatorLog{
+                Allocate(sizeofPool()),
+                Allocate(sizeofStringBuffer()),
+                Reallocate(sizeofStringBuffer(), sizeofString("hello\nworld")),
+                Reallocate(sizeofPool(), sizeofArray(1)),
+            });
+  }
+
+  SECTION("std::string") {
+    std::string input = "['hello',\"world\"]";
+
+    DeserializationError err = deserializeJson(doc, input, CopyFromInput);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[\"hello\",\"world\"]");
+    REQUIRE(spy.log() ==
+            AllocatorLog{
+                Allocate(sizeofPool()),
+                Allocate(sizeofString("hello")),
+                Allocate(sizeofString("world")),
+                Reallocate(sizeofPool(), sizeofArray(2)),
+            });
+  }
+
+  SECTION("char* and size") {
+    DeserializationError err =
+        deserializeJson(doc, "[\"hello\"]garbage", 9, CopyFromInput);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[\"hello\"]");
+  }
+
+  SECTION("incomplete string") {
+    DeserializationError err =
+        deserializeJson(doc, "[\"hello\"]", 6, CopyFromInput);
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("string allocation fails") {
+    JsonDocument failingDoc(FailingAllocator::instance());
+
+    DeserializationError err =
+        deserializeJson(failingDoc, "\"hello\"", CopyFromInput);
+
+    REQUIRE(err == DeserializationError::NoMemory);
+  }
+
+  SECTION("streams use the StringBuilder") {
+    std::istringstream input("\"hello\"");
+
+    DeserializationError err = deserializeJson(doc, input, CopyFromInput);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc == "hello");
+    REQUIRE(spy.log() ==
+            AllocatorLog{
+                Allocate(sizeofStringBuffer()),
+                Reallocate(sizeofStringBuffer(), sizeofString("hello")),
+            });
+  }
+
+  SECTION("with filter") {
+    JsonDocument filter;
+    filter["b"] = true;
+
+    DeserializationError err =
+        deserializeJson(doc, "{\"a\":\"hello\",\"b\":\"world\"}", CopyFromInput,
+                        DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"b\":\"world\"}");
+  }
+}
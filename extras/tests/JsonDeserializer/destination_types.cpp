@@ -29,6 +29,18 @@ TEST_CASE("deserializeJson(JsonDocument&)") {
                            Allocate(sizeofPool()),
                            Reallocate(sizeofPool(), sizeofArray(1)),
                        });
+
+  SECTION("reuses the pools after reserve()") {
+    doc.reserve(1);
+    deserializeJson(doc, "[42]");
+    spy.clearLog();
+
+    err = deserializeJson(doc, "[43]");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[43]");
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
 }
 
 TEST_CASE("deserializeJson(JsonVariant)") {
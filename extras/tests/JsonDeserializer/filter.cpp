@@ -712,6 +712,29 @@ TEST_CASE("Filtering") {
 
       doc.shrinkToFit();
       CHECK(spy.allocatedBytes() == tc.memoryUsage);
+
+      // skipped values are read in place from a contiguous input, but not
+      // from a stream
+      std::istringstream stream(tc.input);
+      CHECK(deserializeJson(
+                doc, stream, DeserializationOption::Filter(filter),
+                DeserializationOption::NestingLimit(tc.nestingLimit)) ==
+            tc.error);
+      CHECK(doc.as<std::string>() == tc.output);
+
+      CHECK(deserializeJson(
+                doc, tc.input, strlen(tc.input),
+                DeserializationOption::Filter(filter),
+                DeserializationOption::NestingLimit(tc.nestingLimit)) ==
+            tc.error);
+      CHECK(doc.as<std::string>() == tc.output);
+
+      CompiledFilter compiledFilter(filter);
+      CHECK(deserializeJson(
+                doc, tc.input, compiledFilter.filter(),
+                DeserializationOption::NestingLimit(tc.nestingLimit)) ==
+            tc.error);
+      CHECK(doc.as<std::string>() == tc.output);
     }
   }
 }
@@ -0,0 +1,90 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_DECODE_UNICODE 1
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+
+#include "LoggingHandler.hpp"
+
+TEST_CASE("deserializeJson(JsonHandler&)") {
+  LoggingHandler handler;
+
+  SECTION("sends the values in order") {
+    DeserializationError err = deserializeJson(
+        handler, "{\"a\":[1,-2,3.5,true,false,null],\"b\":{},'c':[]}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(handler.str() ==
+            "{ key:a [ uint:1 int:-2 float:3.5 true false null ] "
+            "key:b { } key:c [ ] }");
+  }
+
+  SECTION("unescapes the strings") {
+    DeserializationError err =
+        deserializeJson(handler, "[\"x\\ty\",\"\\u00e4\"]");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(handler.str() == "[ string:x\ty string:\xc3\xa4 ]");
+  }
+
+  SECTION("supports unquoted keys") {
+    DeserializationError err = deserializeJson(handler, "{key:'value'}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(handler.str() == "{ key:key string:value }");
+  }
+
+  SECTION("supports streams") {
+    std::istringstream input("[\"hello\",42]");
+
+    DeserializationError err = deserializeJson(handler, input);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(handler.str() == "[ string:hello uint:42 ]");
+  }
+
+  SECTION("supports InSitu") {
+    char input[] = "{\"hello\":\"world\"}";
+
+    DeserializationError err =
+        deserializeJson(handler, input, DeserializationOption::InSitu);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(handler.str() == "{ key:hello string:world }");
+  }
+
+  SECTION("supports CopyFromInput") {
+    DeserializationError err =
+        deserializeJson(handler, std::string("[\"hello\",\"world\"]"),
+                        DeserializationOption::CopyFromInput);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(handler.str() == "[ string:hello string:world ]");
+  }
+
+  SECTION("supports NestingLimit") {
+    DeserializationError err = deserializeJson(
+        handler, "[[]]", DeserializationOption::NestingLimit(1));
+
+    REQUIRE(err == DeserializationError::TooDeep);
+    REQUIRE(handler.str() == "[");
+  }
+
+  SECTION("EmptyInput") {
+    DeserializationError err = deserializeJson(handler, "  ");
+
+    REQUIRE(err == DeserializationError::EmptyInput);
+    REQUIRE(handler.str() == "");
+  }
+
+  SECTION("IncompleteInput") {
+    DeserializationError err = deserializeJson(handler, "[1,tr");
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+    REQUIRE(handler.str() == "[ uint:1");
+  }
+}
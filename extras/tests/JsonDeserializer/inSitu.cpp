@@ -0,0 +1,137 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_DECODE_UNICODE 1
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+
+using DeserializationOption::InSitu;
+
+template <size_t N>
+static bool isInBuffer(const char (&buffer)[N], const char* s) {
+  return s >= buffer && s < buffer + N;
+}
+
+TEST_CASE("deserializeJson(char*, InSitu)") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("stores the strings in the input buffer") {
+    char input[] = "{\"hello\":[\"world\",42]}";
+
+    DeserializationError err = deserializeJson(doc, input, InSitu);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["hello"][0] == "world");
+    REQUIRE(doc["hello"][1] == 42);
+    REQUIRE(isInBuffer(input, doc["hello"][0].as<const char*>()));
+    REQUIRE(isInBuffer(input, doc.as<JsonObject>().begin()->key().c_str()));
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Reallocate(sizeofPool(), sizeofPool(4)),
+                         });
+  }
+
+  SECTION("unescapes the strings in place") {
+    char input[] =
+        "[\"1\\\"2\\\\3\\/4\\b5\\f6\\n7\\r8\\t9\",'\\u00e4\\ud83d\\udda4']";
+
+    DeserializationError err = deserializeJson(doc, input, InSitu);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == "1\"2\\3/4\b5\f6\n7\r8\t9");
+    REQUIRE(doc[1] == "\xc3\xa4\xf0\x9f\x96\xa4");
+    REQUIRE(isInBuffer(input, doc[0].as<const char*>()));
+    REQUIRE(isInBuffer(input, doc[1].as<const char*>()));
+  }
+
+  SECTION("copies the strings that contain \\u0000") {
+    char input[] = "[\"wx\\u0000yz\"]";
+
+    DeserializationError err = deserializeJson(doc, input, InSitu);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0].as<JsonString>().size() == 5);
+    REQUIRE(doc[0] == std::string("wx\0yz", 5));
+    REQUIRE(!isInBuffer(input, doc[0].as<const char*>()));
+  }
+
+  SECTION("copies the non-quoted keys") {
+    char input[] = "{hello:'world'}";
+
+    DeserializationError err = deserializeJson(doc, input, InSitu);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["hello"] == "world");
+    REQUIRE(!isInBuffer(input, doc.as<JsonObject>().begin()->key().c_str()));
+    REQUIRE(isInBuffer(input, doc["hello"].as<const char*>()));
+  }
+
+  SECTION("duplicate keys") {
+    char input[] = "{\"a\":1,\"a\":2}";
+
+    DeserializationError err = deserializeJson(doc, input, InSitu);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":2}");
+  }
+
+  SECTION("incomplete string") {
+    char input[] = "[\"hello";
+
+    DeserializationError err = deserializeJson(doc, input, InSitu);
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("null input") {
+    DeserializationError err =
+        deserializeJson(doc, static_cast<char*>(nullptr), InSitu);
+
+    REQUIRE(err == DeserializationError::EmptyInput);
+  }
+
+  SECTION("with size") {
+    char input[] = "[\"hello\",\"world\"]garbage";
+
+    DeserializationError err = deserializeJson(doc, input, 17, InSitu);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[\"hello\",\"world\"]");
+    REQUIRE(isInBuffer(input, doc[1].as<const char*>()));
+  }
+
+  SECTION("with size, incomplete string") {
+    char input[] = "[\"hello\"]";
+
+    DeserializationError err = deserializeJson(doc, input, 5, InSitu);
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("with filter") {
+    char input[] = "{\"a\":\"hello\",\"b\":\"world\"}";
+    JsonDocument filter;
+    filter["b"] = true;
+
+    DeserializationError err = deserializeJson(
+        doc, input, InSitu, DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"b\":\"world\"}");
+  }
+
+  SECTION("with nesting limit") {
+    char input[] = "[\"hello\"]";
+
+    DeserializationError err = deserializeJson(
+        doc, input, InSitu, DeserializationOption::NestingLimit(0));
+
+    REQUIRE(err == DeserializationError::TooDeep);
+  }
+}
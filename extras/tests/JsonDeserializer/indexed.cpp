@@ -0,0 +1,219 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_DECODE_UNICODE 1
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+
+static void checkSameAsSerial(const std::string& input) {
+  JsonDocument expected, actual;
+
+  DeserializationError expectedErr = deserializeJson(expected, input);
+  DeserializationError actualErr =
+      deserializeJsonIndexed(actual, input.c_str(), input.size());
+
+  CAPTURE(input);
+  REQUIRE(actualErr == expectedErr);
+  REQUIRE(actual.as<std::string>() == expected.as<std::string>());
+}
+
+TEST_CASE("deserializeJsonIndexed()") {
+  SECTION("gives the same result as deserializeJson()") {
+    checkSameAsSerial("[]");
+    checkSameAsSerial(" {} ");
+    checkSameAsSerial("[1,-2,3.5,1e3,true,false,null]");
+    checkSameAsSerial("{\"a\":{\"b\":[[],{},[{\"c\":\"d\"}]]}}");
+    checkSameAsSerial("{\"a\":1,\"a\":2}");
+    checkSameAsSerial("{a:1, b_c : [ ] }");
+    checkSameAsSerial("[\"x\\ty\",\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"]");
+    checkSameAsSerial("[\"\\u00e4\\ud83d\\udda4\"]");
+    checkSameAsSerial("[\"[{:,}]\"]");
+    checkSameAsSerial("[1,2] trailing");
+  }
+
+  SECTION("strings and escape sequences across the blocks") {
+    // the blocks are 64 characters long
+    for (size_t padding = 50; padding < 70; padding++) {
+      std::string input = "[\"" + std::string(padding, ' ') +
+                          "\\\\\",\"\\\"]\",\"\\\\\\\"\"," +
+                          std::string(padding, ' ') + "\"\\\\\"]";
+      checkSameAsSerial(input);
+    }
+  }
+
+  SECTION("a large array") {
+    std::string input = "[";
+    for (int i = 0; i < 1000; i++) {
+      if (i)
+        input += ",\n";
+      input += "{\"id\":" + std::to_string(i) + ",\"name\":\"item \\\"" +
+               std::to_string(i) + "\\\"\",\"tags\":[\"a\",{\"b\":[1.5]}]}";
+    }
+    input += "]";
+
+    checkSameAsSerial(input);
+  }
+
+  SECTION("falls back to deserializeJson()") {
+    checkSameAsSerial("42");
+    checkSameAsSerial("\"hello\"");
+    checkSameAsSerial("");
+    checkSameAsSerial("['hello']");
+    checkSameAsSerial(std::string("[1,\0,2]", 7));
+  }
+
+  SECTION("errors") {
+    checkSameAsSerial("[1,2");
+    checkSameAsSerial("[1 2]");
+    checkSameAsSerial("[1,]");
+    checkSameAsSerial("[tru]");
+    checkSameAsSerial("[\"abc");
+    checkSameAsSerial("[\"\\x\"]");
+    checkSameAsSerial("[\"\\u00\"]");
+    checkSameAsSerial("{\"a\" 1}");
+    checkSameAsSerial("{\"a\":}");
+    checkSameAsSerial("{,}");
+    checkSameAsSerial("[1}");
+    checkSameAsSerial("[1,2]]");
+  }
+
+  SECTION("null-terminated input") {
+    JsonDocument doc;
+
+    DeserializationError err = deserializeJsonIndexed(doc, "[1,2]");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[1,2]");
+  }
+}
+
+TEST_CASE("deserializeJsonIndexed() with options") {
+  JsonDocument doc;
+
+  SECTION("filter") {
+    JsonDocument filter;
+    filter[0]["id"] = true;
+    const char* input =
+        "[{\"id\":1,\"x\":{\"y\":[1,\"]\"]}},{\"x\":\"}\",\"id\":2},"
+        "{\"id\":\"3\",\"x\":[[{}]]}]";
+
+    DeserializationError err = deserializeJsonIndexed(
+        doc, input, DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[{\"id\":1},{\"id\":2},{\"id\":\"3\"}]");
+  }
+
+  SECTION("validates the rejected values") {
+    JsonDocument filter;
+    filter["a"] = true;
+    const char* input = "{\"a\":1,\"b\":[1,,x]}";
+
+    DeserializationError err = deserializeJsonIndexed(
+        doc, input, DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::InvalidInput);
+    REQUIRE(err == deserializeJson(doc, input,
+                                   DeserializationOption::Filter(filter)));
+  }
+
+  SECTION("checks that the brackets of the rejected values match") {
+    JsonDocument filter;
+    filter["a"] = true;
+
+    DeserializationError err = deserializeJsonIndexed(
+        doc, "{\"a\":1,\"b\":[1}}", DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::InvalidInput);
+  }
+
+  SECTION("nesting limit") {
+    const char* input = "[{\"a\":[1]},2]";
+
+    REQUIRE(deserializeJsonIndexed(doc, input,
+                                   DeserializationOption::NestingLimit(3)) ==
+            DeserializationError::Ok);
+    REQUIRE(deserializeJsonIndexed(doc, input,
+                                   DeserializationOption::NestingLimit(2)) ==
+            DeserializationError::TooDeep);
+  }
+}
+
+TEST_CASE("deserializeJsonIndexed() memory") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("releases the index") {
+    DeserializationError err = deserializeJsonIndexed(doc, "[\"hello\"]");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(67 * 4),
+                             Allocate(sizeofPool()),
+                             Allocate(sizeofStringBuffer()),
+                             Reallocate(sizeofStringBuffer(),
+                                        sizeofString("hello")),
+                             Reallocate(sizeofPool(), sizeofPool(1)),
+                             Deallocate(67 * 4),
+                         });
+  }
+
+  SECTION("falls back to deserializeJson() if the index doesn't fit") {
+    TimebombAllocator timebomb(0);
+    JsonDocument doc2(&timebomb);
+
+    DeserializationError err = deserializeJsonIndexed(doc2, "[1,2]");
+
+    REQUIRE(err == DeserializationError::NoMemory);
+  }
+}
+
+TEST_CASE("StructuralIndex") {
+  using namespace ArduinoJson::detail;
+
+  SECTION("the classifiers agree") {
+    const char chars[] = "a\"\\{}[]:,'/\0 \x7f\xff\x5b\x5d\x7b";
+    std::string block;
+    for (size_t i = 0; i < 64; i++)
+      block += chars[i % (sizeof(chars) - 1)];
+
+    CharMasks expected, actual;
+    classifyCharsScalar(block.c_str(), expected);
+
+    classifyCharsSwar(block.c_str(), actual);
+    REQUIRE(actual.quotes == expected.quotes);
+    REQUIRE(actual.backslashes == expected.backslashes);
+    REQUIRE(actual.structurals == expected.structurals);
+    REQUIRE(actual.unsupported == expected.unsupported);
+    REQUIRE(actual.nulls == expected.nulls);
+  }
+
+  SECTION("positions") {
+    StructuralIndex index(DefaultAllocator::instance());
+    const char* input = "{\"a\\\"\":[1, \"]\"]}";
+
+    REQUIRE(index.build(input, strlen(input)) == true);
+
+    uint32_t expected[] = {0, 1, 5, 6, 7, 9, 11, 13, 14, 15, 16};
+    REQUIRE(index.size() == sizeof(expected) / sizeof(expected[0]));
+    for (size_t i = 0; i < index.size(); i++) {
+      CAPTURE(i);
+      REQUIRE(index[i] == expected[i]);
+    }
+  }
+
+  SECTION("unsupported inputs") {
+    StructuralIndex index(DefaultAllocator::instance());
+
+    REQUIRE(index.build("[\"abc]", 6) == false);
+    REQUIRE(index.build("['abc']", 7) == false);
+    REQUIRE(index.build("[1]//", 5) == false);
+    REQUIRE(index.build("[\"\0\"]", 5) == false);
+    REQUIRE(index.build("[\"'/\"]", 6) == true);
+  }
+}
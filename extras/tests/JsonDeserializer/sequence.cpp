@@ -0,0 +1,126 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+#include "Allocators.hpp"
+
+TEST_CASE("deserializeJsonSequence()") {
+  JsonDocument doc;
+
+  SECTION("reads newline-delimited values") {
+    const char* input = "{\"a\":1}\n[2]\n\"three\"\n";
+    auto values = deserializeJsonSequence(doc, input);
+
+    REQUIRE(values.next() == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":1}");
+    REQUIRE(values.next() == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[2]");
+    REQUIRE(values.next() == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "three");
+    REQUIRE(values.next() == DeserializationError::EmptyInput);
+    REQUIRE(doc.isNull());
+  }
+
+  SECTION("reads concatenated values") {
+    const char* input = "{}[]1 2.5 true";
+    auto values = deserializeJsonSequence(doc, input, strlen(input));
+
+    std::string log;
+    while (values.next() == DeserializationError::Ok)
+      log += doc.as<std::string>() + ";";
+
+    REQUIRE(log == "{};[];1;2.5;true;");
+  }
+
+  SECTION("reads a stream") {
+    std::istringstream input("[1]\r\n[2]\r\n");
+    auto values = deserializeJsonSequence(doc, input);
+
+    REQUIRE(values.next() == DeserializationError::Ok);
+    REQUIRE(doc[0] == 1);
+    REQUIRE(values.next() == DeserializationError::Ok);
+    REQUIRE(doc[0] == 2);
+    REQUIRE(values.next() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("skips the rest of the line after an error") {
+    const char* input = "[1]\n[2,}, 42]\n[3]";
+    auto values = deserializeJsonSequence(doc, input);
+
+    REQUIRE(values.next() == DeserializationError::Ok);
+    REQUIRE(values.next() == DeserializationError::InvalidInput);
+    REQUIRE(values.next() == DeserializationError::Ok);
+    REQUIRE(doc[0] == 3);
+    REQUIRE(values.next() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("drops the values after an error on the same line") {
+    const char* input = "{\"a\":x}{\"b\":1}\n[3]";
+    auto values = deserializeJsonSequence(doc, input);
+
+    REQUIRE(values.next() == DeserializationError::InvalidInput);
+    REQUIRE(values.next() == DeserializationError::Ok);
+    REQUIRE(doc[0] == 3);
+    REQUIRE(values.next() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("reports an incomplete value at the end") {
+    const char* input = "[1]\n[\"abc";
+    auto values = deserializeJsonSequence(doc, input);
+
+    REQUIRE(values.next() == DeserializationError::Ok);
+    REQUIRE(values.next() == DeserializationError::IncompleteInput);
+    REQUIRE(values.next() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("supports the options") {
+    JsonDocument filter;
+    filter["a"] = true;
+    const char* input = "{\"a\":1,\"b\":2}\n[[[3]]]\n";
+    auto values = deserializeJsonSequence(
+        doc, input, DeserializationOption::Filter(filter),
+        DeserializationOption::NestingLimit(2));
+
+    REQUIRE(values.next() == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":1}");
+    REQUIRE(values.next() == DeserializationError::TooDeep);
+  }
+}
+
+TEST_CASE("deserializeJsonSequence() reuses the memory") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+  const char* input = "[\"hello\"]\n[\"world\"]\n";
+  auto values = deserializeJsonSequence(doc, input);
+
+  REQUIRE(values.next() == DeserializationError::Ok);
+  spy.clearLog();
+  REQUIRE(values.next() == DeserializationError::Ok);
+
+  REQUIRE(doc[0] == "world");
+  REQUIRE(spy.log() == AllocatorLog{
+                           Deallocate(sizeofString("hello")),
+                           Allocate(sizeofStringBuffer()),
+                           Reallocate(sizeofStringBuffer(),
+                                      sizeofString("world")),
+                       });
+}
+
+TEST_CASE("deserializeJsonSequence() with clear() between the values") {
+  JsonDocument doc;
+  doc.useStringArena();
+  const char* input = "{\"a\":\"a\"}\n{\"b\":\"world\"}\n";
+  auto values = deserializeJsonSequence(doc, input);
+
+  REQUIRE(values.next() == DeserializationError::Ok);
+  REQUIRE(doc.as<std::string>() == "{\"a\":\"a\"}");
+  doc.clear();
+  REQUIRE(values.next() == DeserializationError::Ok);
+  REQUIRE(doc.as<std::string>() == "{\"b\":\"world\"}");
+}
@@ -0,0 +1,101 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+using namespace DeserializationOption;
+
+template <typename TStaticFilter>
+static void checkSameAsFilter(const char* filterJson, const char* input) {
+  JsonDocument filter;
+  REQUIRE(deserializeJson(filter, filterJson) == DeserializationError::Ok);
+
+  JsonDocument expected, actual;
+  DeserializationError expectedErr =
+      deserializeJson(expected, input, Filter(filter));
+  DeserializationError actualErr =
+      deserializeJson(actual, input, TStaticFilter());
+
+  CAPTURE(filterJson);
+  CAPTURE(input);
+  REQUIRE(actualErr == expectedErr);
+  REQUIRE(actual.as<std::string>() == expected.as<std::string>());
+}
+
+TEST_CASE("StaticFilter") {
+  const char* input =
+      "{\"a\":1,\"b\":[1,{\"c\":2}],\"*\":3,\"d\":{\"e\":4,\"f\":5},"
+      "\"ab\":[6],\"\":7}";
+
+  SECTION("no members") {
+    checkSameAsFilter<StaticFilter<>>("true", input);
+  }
+
+  SECTION("members") {
+    checkSameAsFilter<StaticFilter<Member<ARDUINOJSON_STRING("a")>>>(
+        "{\"a\":true}", input);
+    checkSameAsFilter<StaticFilter<Member<ARDUINOJSON_STRING("ab")>,
+                                   Member<ARDUINOJSON_STRING("a")>>>(
+        "{\"ab\":true,\"a\":true}", input);
+    checkSameAsFilter<StaticFilter<Member<ARDUINOJSON_STRING("")>>>(
+        "{\"\":true}", input);
+    checkSameAsFilter<StaticFilter<Member<ARDUINOJSON_STRING("z")>>>(
+        "{\"z\":true}", input);
+  }
+
+  SECTION("nested object") {
+    checkSameAsFilter<StaticFilter<
+        Member<ARDUINOJSON_STRING("d"), Member<ARDUINOJSON_STRING("f")>>>>(
+        "{\"d\":{\"f\":true}}", input);
+  }
+
+  SECTION("array") {
+    checkSameAsFilter<StaticFilter<Member<
+        ARDUINOJSON_STRING("b"), Each<Member<ARDUINOJSON_STRING("c")>>>>>(
+        "{\"b\":[{\"c\":true}]}", input);
+    checkSameAsFilter<StaticFilter<Member<ARDUINOJSON_STRING("b"), Each<>>>>(
+        "{\"b\":[true]}", input);
+    checkSameAsFilter<StaticFilter<Each<Member<ARDUINOJSON_STRING("a")>>>>(
+        "[{\"a\":true}]", "[1,[2],{\"a\":3,\"b\":4}]");
+    checkSameAsFilter<StaticFilter<Each<Each<>>>>("[[true]]",
+                                                  "[1,[2],{\"a\":3}]");
+  }
+
+  SECTION("wildcard") {
+    checkSameAsFilter<StaticFilter<
+        Member<ARDUINOJSON_STRING("*"), Member<ARDUINOJSON_STRING("e")>>>>(
+        "{\"*\":{\"e\":true}}", input);
+    checkSameAsFilter<StaticFilter<
+        Member<ARDUINOJSON_STRING("a")>,
+        Member<ARDUINOJSON_STRING("*"), Member<ARDUINOJSON_STRING("e")>>>>(
+        "{\"a\":true,\"*\":{\"e\":true}}", input);
+    checkSameAsFilter<StaticFilter<Member<ARDUINOJSON_STRING("*")>>>(
+        "{\"*\":true}", "[1,[2],{\"a\":3}]");
+  }
+
+  SECTION("long names") {
+    using Name = ARDUINOJSON_STRING("0123456789abcdef0123456789ABCDEF");
+
+    REQUIRE(Name::size() == 32);
+    REQUIRE(std::string(Name::data()) == "0123456789abcdef0123456789ABCDEF");
+  }
+}
+
+TEST_CASE("deserializeMsgPack() with a StaticFilter") {
+  JsonDocument doc;
+  DeserializationError err = deserializeMsgPack(
+      doc,
+      "\x83\xA7include\x01\xA6ignore\x02"
+      "\xA4list\x92\x82\xA2id\x01\xA1x\x02\x81\xA1x\x03",
+      36,
+      StaticFilter<Member<ARDUINOJSON_STRING("include")>,
+                   Member<ARDUINOJSON_STRING("list"),
+                          Each<Member<ARDUINOJSON_STRING("id")>>>>());
+
+  CHECK(err == DeserializationError::Ok);
+  CHECK(doc.as<std::string>() == "{\"include\":1,\"list\":[{\"id\":1},{}]}");
+}
@@ -0,0 +1,199 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_DECODE_UNICODE 1
+#define ARDUINOJSON_ENABLE_COMMENTS 1
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+
+// Feeds the input one character at a time
+static JsonStreamParser::Status feedBytes(JsonStreamParser& parser,
+                                          const std::string& input) {
+  auto status = JsonStreamParser::NeedMoreData;
+  for (size_t i = 0; i < input.size(); i++) {
+    status = parser.feed(input.data() + i, 1);
+    if (status != JsonStreamParser::NeedMoreData)
+      break;
+  }
+  return status;
+}
+
+TEST_CASE("JsonStreamParser") {
+  JsonDocument doc;
+  JsonStreamParser parser(doc);
+
+  SECTION("parses a complete input") {
+    auto status = parser.feed("{\"hello\":[\"world\",42,true,null]}");
+
+    REQUIRE(status == JsonStreamParser::Done);
+    REQUIRE(parser.error() == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"hello\":[\"world\",42,true,null]}");
+  }
+
+  SECTION("parses an input split in two chunks") {
+    REQUIRE(parser.feed("{\"hel") == JsonStreamParser::NeedMoreData);
+    REQUIRE(parser.feed("lo\":\"world\"}") == JsonStreamParser::Done);
+
+    REQUIRE(doc["hello"] == "world");
+  }
+
+  SECTION("gives the same result as deserializeJson()") {
+    const char* inputs[] = {
+        "[1,-2,3.5,1e3,true,false,null]",
+        "{'a':1,b:\"x\\ty\",\"c\":{\"d\":[[],{}]}}",
+        "[\"\\u00e4\\ud83d\\udda4\",\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"]",
+        " \t\r\n[ 1 , 2 ]",
+        "[/* comment */1,// comment\n2]",
+        "{\"a\":1,\"a\":2}",
+        "\"hello world, this string is long enough to need a larger buffer\"",
+    };
+    for (auto input : inputs) {
+      JsonDocument expected;
+      deserializeJson(expected, input);
+
+      INFO(input);
+      parser.reset();
+      REQUIRE(feedBytes(parser, input) == JsonStreamParser::Done);
+      REQUIRE(doc == expected);
+
+      parser.reset();
+      REQUIRE(parser.feed(input) == JsonStreamParser::Done);
+      REQUIRE(doc == expected);
+    }
+  }
+
+  SECTION("stops at the end of the value") {
+    auto status = parser.feed("[1,2] [3]");
+
+    REQUIRE(status == JsonStreamParser::Done);
+    REQUIRE(parser.consumed() == 5);
+    REQUIRE(doc.as<std::string>() == "[1,2]");
+  }
+
+  SECTION("consumes nothing once done") {
+    parser.feed("true");
+    auto status = parser.feed("false");
+
+    REQUIRE(status == JsonStreamParser::Done);
+    REQUIRE(parser.consumed() == 0);
+    REQUIRE(doc.as<bool>() == true);
+  }
+
+  SECTION("needs finish() to complete a number at the root") {
+    REQUIRE(parser.feed("4") == JsonStreamParser::NeedMoreData);
+    REQUIRE(parser.feed("2") == JsonStreamParser::NeedMoreData);
+    REQUIRE(parser.finish() == JsonStreamParser::Done);
+
+    REQUIRE(doc.as<int>() == 42);
+  }
+
+  SECTION("a space terminates a number at the root") {
+    REQUIRE(parser.feed("42 ") == JsonStreamParser::Done);
+    REQUIRE(parser.consumed() == 2);
+
+    REQUIRE(doc.as<int>() == 42);
+  }
+
+  SECTION("reset() empties the document") {
+    parser.feed("[1,2");
+    parser.reset();
+
+    REQUIRE(doc.isNull());
+    REQUIRE(parser.feed("[3]") == JsonStreamParser::Done);
+    REQUIRE(doc.as<std::string>() == "[3]");
+  }
+}
+
+TEST_CASE("JsonStreamParser errors") {
+  JsonDocument doc;
+  JsonStreamParser parser(doc);
+
+  SECTION("EmptyInput") {
+    parser.feed("  ");
+
+    REQUIRE(parser.finish() == JsonStreamParser::Error);
+    REQUIRE(parser.error() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("IncompleteInput") {
+    const char* inputs[] = {"[1,", "{\"a\"", "\"abc", "\"\\u00", "tr", "/*"};
+    for (auto input : inputs) {
+      INFO(input);
+      parser.reset();
+      REQUIRE(parser.feed(input) == JsonStreamParser::NeedMoreData);
+      REQUIRE(parser.finish() == JsonStreamParser::Error);
+      REQUIRE(parser.error() == DeserializationError::IncompleteInput);
+    }
+  }
+
+  SECTION("stops at a null character") {
+    auto status = parser.feed("[1,\0,2]", 7);
+
+    REQUIRE(status == JsonStreamParser::Error);
+    REQUIRE(parser.error() == DeserializationError::IncompleteInput);
+    REQUIRE(parser.consumed() == 3);
+  }
+
+  SECTION("InvalidInput") {
+    const char* inputs[] = {"[1}", "{\"a\" 1}", "[1,]", "tru3", "\"\\x\"",
+                            "{,}", "/-"};
+    for (auto input : inputs) {
+      INFO(input);
+      parser.reset();
+      REQUIRE(feedBytes(parser, input) == JsonStreamParser::Error);
+      REQUIRE(parser.error() == DeserializationError::InvalidInput);
+    }
+  }
+
+  SECTION("TooDeep") {
+    std::string input(ARDUINOJSON_DEFAULT_NESTING_LIMIT, '[');
+
+    REQUIRE(parser.feed(input.c_str()) == JsonStreamParser::NeedMoreData);
+    REQUIRE(parser.feed("[") == JsonStreamParser::Error);
+    REQUIRE(parser.error() == DeserializationError::TooDeep);
+  }
+
+  SECTION("keeps the error") {
+    parser.feed("]");
+
+    REQUIRE(parser.feed("[]") == JsonStreamParser::Error);
+    REQUIRE(parser.consumed() == 0);
+    REQUIRE(parser.error() == DeserializationError::InvalidInput);
+  }
+}
+
+TEST_CASE("JsonStreamParser memory") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("NoMemory") {
+    TimebombAllocator timebomb(1);
+    JsonDocument doc2(&timebomb);
+    JsonStreamParser parser(doc2);
+
+    REQUIRE(parser.feed("[\"hello\"]") == JsonStreamParser::Error);
+    REQUIRE(parser.error() == DeserializationError::NoMemory);
+  }
+
+  SECTION("releases the string buffer when done") {
+    {
+      JsonStreamParser parser(doc);
+      REQUIRE(parser.feed("[\"hel") == JsonStreamParser::NeedMoreData);
+      REQUIRE(parser.feed("lo\"]") == JsonStreamParser::Done);
+    }
+
+    REQUIRE(doc[0] == "hello");
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Allocate(sizeofStringBuffer()),
+                             Reallocate(sizeofStringBuffer(),
+                                        sizeofString("hello")),
+                             Reallocate(sizeofPool(), sizeofPool(1)),
+                         });
+  }
+}
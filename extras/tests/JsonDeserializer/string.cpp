@@ -212,3 +212,83 @@ TEST_CASE("Deduplicate keys") {
               Reallocate(sizeofPool(), sizeofArray(2) + 2 * sizeofObject(1)),
           });
 }
+
+TEST_CASE("Long JSON strings") {  // the scanner reads them a word at a time
+  JsonDocument doc;
+  std::string padding(40, 'x');
+
+  SECTION("escape sequences") {
+    for (size_t i = 0; i < padding.size(); i++) {
+      std::string prefix = padding.substr(0, i), suffix = padding.substr(i);
+      std::string input = "\"" + prefix + "\\n\\u00e4\\\"" + suffix + "\"";
+      std::string expected = prefix + "\n\xc3\xa4\"" + suffix;
+      CAPTURE(input);
+
+      REQUIRE(deserializeJson(doc, input) == DeserializationError::Ok);
+      CHECK(doc.as<std::string>() == expected);
+
+      REQUIRE(deserializeJson(doc, input.c_str()) == DeserializationError::Ok);
+      CHECK(doc.as<std::string>() == expected);
+
+      REQUIRE(deserializeJson(doc, input.data(), input.size()) ==
+              DeserializationError::Ok);
+      CHECK(doc.as<std::string>() == expected);
+    }
+  }
+
+  SECTION("other quote") {
+    for (size_t i = 0; i < padding.size(); i++) {
+      std::string prefix = padding.substr(0, i), suffix = padding.substr(i);
+      std::string input = "'" + prefix + "\"" + suffix + "'";
+      CAPTURE(input);
+
+      REQUIRE(deserializeJson(doc, input) == DeserializationError::Ok);
+      CHECK(doc.as<std::string>() == prefix + "\"" + suffix);
+    }
+  }
+
+  SECTION("control character") {
+    for (size_t i = 0; i < padding.size(); i++) {
+      std::string prefix = padding.substr(0, i), suffix = padding.substr(i);
+      std::string input = "\"" + prefix + "\t" + suffix + "\"";
+      CAPTURE(input);
+
+      REQUIRE(deserializeJson(doc, input) == DeserializationError::Ok);
+      CHECK(doc.as<std::string>() == prefix + "\t" + suffix);
+    }
+  }
+
+  SECTION("null character") {
+    for (size_t i = 0; i < padding.size(); i++) {
+      std::string input = "\"" + padding.substr(0, i) + '\0' + "\"";
+      CAPTURE(i);
+
+      REQUIRE(deserializeJson(doc, input) ==
+              DeserializationError::IncompleteInput);
+    }
+  }
+
+  SECTION("truncated") {
+    for (size_t i = 0; i < padding.size(); i++) {
+      std::string input = "\"" + padding.substr(0, i);
+      CAPTURE(input);
+
+      REQUIRE(deserializeJson(doc, input) ==
+              DeserializationError::IncompleteInput);
+      REQUIRE(deserializeJson(doc, input.c_str()) ==
+              DeserializationError::IncompleteInput);
+    }
+  }
+
+  SECTION("spaces") {
+    for (size_t i = 0; i < padding.size(); i++) {
+      std::string spaces(i, ' ');
+      std::string input = spaces + "[" + spaces + "\"a\"" + spaces + ",\t\r\n" +
+                          spaces + "'b'" + spaces + "]" + spaces;
+      CAPTURE(i);
+
+      REQUIRE(deserializeJson(doc, input) == DeserializationError::Ok);
+      CHECK(doc.as<std::string>() == "[\"a\",\"b\"]");
+    }
+  }
+}
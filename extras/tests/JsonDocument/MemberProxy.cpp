@@ -357,6 +357,7 @@ TEST_CASE("MemberProxy under memory constraints") {
     REQUIRE(doc.overflowed() == true);
     REQUIRE(spy.log() == AllocatorLog{
                              Allocate(sizeofPool()),
+                             AllocateFail(sizeofIndexMap()),
                              AllocateFail(sizeofPool()),
                          });
   }
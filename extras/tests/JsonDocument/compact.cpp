@@ -0,0 +1,78 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+#include "Literals.hpp"
+
+using ArduinoJson::detail::sizeofArray;
+using ArduinoJson::detail::sizeofObject;
+
+TEST_CASE("JsonDocument::compact()") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("null") {
+    REQUIRE(doc.compact() == true);
+
+    REQUIRE(doc.isNull());
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("releases the removed slots") {
+    for (int i = 0; i < ARDUINOJSON_POOL_CAPACITY * 2; i++)
+      doc.add(i);
+    for (int i = 0; i < ARDUINOJSON_POOL_CAPACITY * 2 - 3; i++)
+      doc.remove(0);
+    REQUIRE(doc.as<std::string>() ==
+            "[" + std::to_string(ARDUINOJSON_POOL_CAPACITY * 2 - 3) + "," +
+                std::to_string(ARDUINOJSON_POOL_CAPACITY * 2 - 2) + "," +
+                std::to_string(ARDUINOJSON_POOL_CAPACITY * 2 - 1) + "]");
+    auto json = doc.as<std::string>();
+
+    REQUIRE(doc.compact() == true);
+
+    REQUIRE(doc.as<std::string>() == json);
+    REQUIRE(spy.allocatedBytes() == sizeofArray(3));
+  }
+
+  SECTION("releases the removed strings") {
+    doc.useStringArena();
+    for (int i = 0; i < 10; i++)
+      doc[std::to_string(i)] = "value" + std::to_string(i);
+    for (int i = 1; i < 10; i++)
+      doc.remove(std::to_string(i));
+
+    REQUIRE(doc.compact() == true);
+
+    REQUIRE(doc.as<std::string>() == "{\"0\":\"value0\"}");
+    REQUIRE(spy.allocatedBytes() ==
+            sizeofObject(1) + sizeofStringChunk());  // still an arena
+  }
+
+  SECTION("nested collections") {
+    doc["a"].add(1);
+    doc["b"] = 2;
+    doc["a"].add(3);
+
+    REQUIRE(doc.compact() == true);
+
+    REQUIRE(doc.as<std::string>() == "{\"a\":[1,3],\"b\":2}");
+    REQUIRE(spy.allocatedBytes() == sizeofObject(2) + sizeofArray(2));
+  }
+
+  SECTION("keeps the document when allocation fails") {
+    KillswitchAllocator killswitch;
+    JsonDocument doc2(&killswitch);
+    doc2["hello"] = "world"_s;
+    killswitch.on();
+
+    REQUIRE(doc2.compact() == false);
+    REQUIRE(doc2.as<std::string>() == "{\"hello\":\"world\"}");
+  }
+}
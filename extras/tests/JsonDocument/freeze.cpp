@@ -0,0 +1,112 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+#include "Literals.hpp"
+
+TEST_CASE("JsonDocument::freeze()") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("copies the document") {
+    deserializeJson(doc, "{\"hello\":\"world\",\"values\":[1,2,3]}");
+
+    auto frozen = doc.freeze();
+    doc.clear();
+
+    REQUIRE(frozen.overflowed() == false);
+    REQUIRE(frozen.size() == 2);
+    REQUIRE(frozen["hello"] == "world");
+    REQUIRE(frozen["values"][2] == 3);
+    REQUIRE(frozen.as<std::string>() ==
+            "{\"hello\":\"world\",\"values\":[1,2,3]}");
+  }
+
+  SECTION("stores everything in a single block") {
+    for (int i = 0; i < 100; i++)
+      doc[std::to_string(i)] = std::to_string(i * 2);
+    auto allocatedBefore = spy.allocatedBytes();
+    size_t blockSize;
+    {
+      auto frozen = doc.freeze();
+      REQUIRE(frozen.size() == 100);
+      blockSize = spy.allocatedBytes() - allocatedBefore;
+      spy.clearLog();
+    }
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(blockSize),
+                         });
+  }
+
+  SECTION("allocates the block without copying the document twice") {
+    for (int i = 0; i < 1000; i++) {
+      doc["object"][std::to_string(i)] = std::to_string(i);
+      doc["array"].add(i * 0x100000000LL);
+      doc["nested"][size_t(i % 20)].add(i * 0.1);
+    }
+    auto allocatedBefore = spy.allocatedBytes();
+    spy.clearLog();
+
+    auto frozen = doc.freeze();
+
+    REQUIRE(frozen.overflowed() == false);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(spy.allocatedBytes() - allocatedBefore),
+                         });
+    REQUIRE(frozen.as<std::string>() == doc.as<std::string>());
+  }
+
+  SECTION("reading doesn't modify the document") {
+    for (int i = 0; i < 100; i++) {
+      doc["object"][std::to_string(i)] = i;
+      doc["array"].add(i);
+    }
+    auto frozen = doc.freeze();
+    spy.clearLog();
+
+    for (int i = 0; i < 100; i++) {
+      REQUIRE(frozen["object"][std::to_string(i)] == i);
+      REQUIRE(frozen["array"][i] == i);
+    }
+
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("can be moved") {
+    doc["hello"] = "world";
+    auto frozen = doc.freeze();
+
+    FrozenJsonDocument other(std::move(frozen));
+
+    REQUIRE(other["hello"] == "world");
+    REQUIRE(frozen.isNull());
+  }
+
+  SECTION("can be swapped") {
+    doc["hello"] = "world";
+    auto frozen1 = doc.freeze();
+    doc["hello"] = "again";
+    auto frozen2 = doc.freeze();
+
+    swap(frozen1, frozen2);
+
+    REQUIRE(frozen1["hello"] == "again");
+    REQUIRE(frozen2["hello"] == "world");
+  }
+
+  SECTION("fails gracefully") {
+    doc["hello"] = "world";
+
+    FrozenJsonDocument frozen(doc, FailingAllocator::instance());
+
+    REQUIRE(frozen.overflowed() == true);
+    REQUIRE(frozen.isNull());
+  }
+}
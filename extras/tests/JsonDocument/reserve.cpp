@@ -0,0 +1,149 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+#include "Literals.hpp"
+
+using ArduinoJson::detail::sizeofArray;
+
+TEST_CASE("JsonDocument::reserve()") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("allocates the pools") {
+    bool result = doc.reserve(ARDUINOJSON_POOL_CAPACITY + 1);
+
+    REQUIRE(result == true);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()) * 2,
+                         });
+  }
+
+  SECTION("grows the pool list in one step") {
+    bool result = doc.reserve(ARDUINOJSON_POOL_CAPACITY * 10);
+
+    REQUIRE(result == true);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPoolList(10)),
+                             Allocate(sizeofPool()) * 10,
+                         });
+  }
+
+  SECTION("doesn't allocate when enough slots are available") {
+    doc.add(1);
+    spy.clearLog();
+
+    bool result = doc.reserve(ARDUINOJSON_POOL_CAPACITY - 1);
+
+    REQUIRE(result == true);
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("filling the document doesn't call the allocator") {
+    doc.reserve(4, 256);
+    spy.clearLog();
+
+    doc["hello"_s] = "world"_s;
+    doc["key"_s] = "value"_s;
+
+    REQUIRE(doc.as<std::string>() == "{\"hello\":\"world\",\"key\":\"value\"}");
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("deserializeJson() doesn't call the allocator") {
+    doc.reserve(4, 256);
+    spy.clearLog();
+
+    deserializeJson(doc, "{\"hello\":\"world\",\"key\":\"value\"}");
+
+    REQUIRE(doc.as<std::string>() == "{\"hello\":\"world\",\"key\":\"value\"}");
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("deserializeJson() keeps the reserved memory") {
+    doc.reserve(4, 256);
+    deserializeJson(doc, "[1]");
+    spy.clearLog();
+
+    deserializeJson(doc, "{\"hello\":\"world\",\"key\":\"value\"}");
+
+    REQUIRE(doc.as<std::string>() == "{\"hello\":\"world\",\"key\":\"value\"}");
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("shrinkToFit() ends the reservation") {
+    doc.reserve(4);
+    doc.shrinkToFit();
+    spy.clearLog();
+
+    deserializeJson(doc, "[1]");
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Reallocate(sizeofPool(), sizeofArray(1)),
+                         });
+  }
+
+  SECTION("strings overflow to the allocator") {
+    doc.reserve(1, 4);
+    spy.clearLog();
+
+    doc.add("hello world"_s);
+
+    REQUIRE(doc.as<std::string>() == "[\"hello world\"]");
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofString("hello world")),
+                         });
+  }
+
+  SECTION("clear() releases everything") {
+    doc.reserve(1, 64);
+    doc.add("hello"_s);
+    spy.clearLog();
+
+    doc.clear();
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofPool()),
+                             Deallocate(sizeofStringChunk(64)),
+                         });
+  }
+
+  SECTION("reset() keeps the memory for the next content") {
+    doc.reserve(4, 256);
+    doc["hello"_s] = "world"_s;
+    spy.clearLog();
+
+    doc.reset();
+    doc["key"_s] = "value"_s;
+
+    REQUIRE(doc.as<std::string>() == "{\"key\":\"value\"}");
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("shrinkToFit() releases the unused memory") {
+    doc.reserve(ARDUINOJSON_POOL_CAPACITY + 1, 64);
+    spy.clearLog();
+
+    doc.shrinkToFit();
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofPool()) * 2,
+                             Deallocate(sizeofStringChunk(64)),
+                         });
+  }
+
+  SECTION("returns false when allocation fails") {
+    JsonDocument doc2(FailingAllocator::instance());
+
+    REQUIRE(doc2.reserve(1) == false);
+    REQUIRE(doc2.reserve(0, 64) == false);
+    REQUIRE(doc2.reserve(0) == true);
+  }
+}
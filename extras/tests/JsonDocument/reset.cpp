@@ -0,0 +1,82 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+#include "Literals.hpp"
+
+TEST_CASE("JsonDocument::reset()") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("null") {
+    doc.reset();
+
+    REQUIRE(doc.isNull());
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("releases strings but keeps the pools") {
+    doc["hello"_s] = "world"_s;
+    spy.clearLog();
+
+    doc.reset();
+
+    REQUIRE(doc.isNull());
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofString("hello")),
+                             Deallocate(sizeofString("world")),
+                         });
+  }
+
+  SECTION("reuses the pools") {
+    for (int i = 0; i < ARDUINOJSON_POOL_CAPACITY; i++)
+      doc.add(i);
+    spy.clearLog();
+
+    doc.reset();
+    for (int i = 0; i < ARDUINOJSON_POOL_CAPACITY; i++)
+      doc.add(i);
+
+    REQUIRE(doc.size() == ARDUINOJSON_POOL_CAPACITY);
+    REQUIRE(spy.log() == AllocatorLog{
+                             // only the index of the array
+                             Deallocate(sizeofArrayIndex(5)),
+                             Deallocate(sizeofIndexMap()),
+                             Allocate(sizeofIndexMap()),
+                             GrowArrayIndex(0, 5),
+                         });
+  }
+
+  SECTION("shrinkToFit() releases the spare pools") {
+    for (int i = 0; i < ARDUINOJSON_POOL_CAPACITY * 2; i++)
+      doc.add(i);
+    doc.reset();
+    doc.add(1);
+    spy.clearLog();
+
+    doc.shrinkToFit();
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofPool()),
+                             Reallocate(sizeofPool(), sizeofPool(1)),
+                         });
+  }
+
+  SECTION("clear() releases the spare pools") {
+    doc.add(1);
+    doc.reset();
+    spy.clearLog();
+
+    doc.clear();
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofPool()),
+                         });
+  }
+}
@@ -0,0 +1,80 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "Allocators.hpp"
+
+static const int poolCapacity = ARDUINOJSON_POOL_CAPACITY;
+
+TEST_CASE("JsonDocument::setMaxPoolCapacity()") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("pools double in size") {
+    REQUIRE(doc.setMaxPoolCapacity(poolCapacity * 4) == true);
+
+    for (int i = 0; i < poolCapacity * 11; i++)
+      doc.add(i);
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Allocate(sizeofIndexMap()),
+                             GrowArrayIndex(0, 5),
+                             Allocate(sizeofPool(poolCapacity * 2)),
+                             GrowArrayIndex(5, 7),
+                             Allocate(sizeofPool(poolCapacity * 4)),
+                             GrowArrayIndex(7, 8),
+                             Allocate(sizeofPool(poolCapacity * 4)),
+                             GrowArrayIndex(8, 9),
+                         });
+
+    REQUIRE(doc.size() == poolCapacity * 11);
+    for (int i = 0; i < poolCapacity * 11; i++)
+      REQUIRE(doc[i] == i);
+  }
+
+  SECTION("rounds down to a power of two") {
+    doc.setMaxPoolCapacity(poolCapacity * 3);
+
+    for (int i = 0; i < poolCapacity * 5; i++)
+      doc.add(i);
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Allocate(sizeofIndexMap()),
+                             GrowArrayIndex(0, 5),
+                             Allocate(sizeofPool(poolCapacity * 2)),
+                             GrowArrayIndex(5, 7),
+                             Allocate(sizeofPool(poolCapacity * 2)),
+                             GrowArrayIndex(7, 8),
+                         });
+  }
+
+  SECTION("reserve() follows the same growth") {
+    doc.setMaxPoolCapacity(poolCapacity * 4);
+
+    doc.reserve(poolCapacity * 7);
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Allocate(sizeofPool(poolCapacity * 2)),
+                             Allocate(sizeofPool(poolCapacity * 4)),
+                         });
+  }
+
+  SECTION("fails when the document has pools") {
+    doc.add(1);
+
+    REQUIRE(doc.setMaxPoolCapacity(poolCapacity * 4) == false);
+  }
+
+  SECTION("works again after clear()") {
+    doc.add(1);
+    doc.clear();
+
+    REQUIRE(doc.setMaxPoolCapacity(poolCapacity * 4) == true);
+  }
+}
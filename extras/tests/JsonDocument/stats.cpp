@@ -0,0 +1,132 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+#include "Literals.hpp"
+
+using ArduinoJson::detail::sizeofArray;
+using ArduinoJson::detail::sizeofObject;
+using ArduinoJson::detail::sizeofString;
+
+TEST_CASE("JsonDocument::stats()") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("empty document") {
+    auto stats = doc.stats();
+
+    REQUIRE(stats.slotsUsed == 0);
+    REQUIRE(stats.slotsFree == 0);
+    REQUIRE(stats.poolCount == 0);
+    REQUIRE(stats.stringCount == 0);
+    REQUIRE(stats.stringBytes == 0);
+    REQUIRE(stats.dedupHits == 0);
+    REQUIRE(stats.allocatorCalls == 0);
+    REQUIRE(stats.allocatedBytes == 0);
+    REQUIRE(stats.peakUsage == 0);
+  }
+
+  SECTION("counts the slots and the strings") {
+    doc["hello"_s] = "world"_s;
+    doc["key"_s] = "world"_s;
+
+    auto stats = doc.stats();
+
+    REQUIRE(stats.slotsUsed == 4);
+    REQUIRE(stats.slotsFree == ARDUINOJSON_POOL_CAPACITY - 4);
+    REQUIRE(stats.poolCount == 1);
+    REQUIRE(stats.stringCount == 3);
+    REQUIRE(stats.stringBytes ==
+            sizeofString(5) * 2 + sizeofString(3));  // hello, world, key
+    REQUIRE(stats.dedupHits == 1);
+    REQUIRE(stats.allocatorCalls == 4);
+    REQUIRE(stats.allocatedBytes == spy.allocatedBytes());
+    REQUIRE(stats.peakUsage == sizeofObject(2) + stats.stringBytes);
+  }
+
+  SECTION("updates the counters on removal") {
+    doc["hello"_s] = "world"_s;
+    doc["key"_s] = "value"_s;
+    auto peak = doc.stats().peakUsage;
+
+    doc.remove("key"_s);
+    auto stats = doc.stats();
+
+    REQUIRE(stats.slotsUsed == 2);
+    REQUIRE(stats.slotsFree == ARDUINOJSON_POOL_CAPACITY - 2);
+    REQUIRE(stats.stringCount == 2);
+    REQUIRE(stats.stringBytes == sizeofString(5) * 2);
+    REQUIRE(stats.peakUsage == peak);
+  }
+
+  SECTION("deserializeJson() deduplicates the strings") {
+    deserializeJson(doc, "[\"hello\",\"hello\",\"hello\"]");
+
+    auto stats = doc.stats();
+
+    REQUIRE(stats.slotsUsed == 3);
+    REQUIRE(stats.slotsFree == 0);  // auto shrink
+    REQUIRE(stats.stringCount == 1);
+    REQUIRE(stats.dedupHits == 2);
+    REQUIRE(stats.peakUsage == sizeofArray(3) + sizeofString(5));
+  }
+
+  SECTION("reset() keeps the pools") {
+    for (int i = 0; i < ARDUINOJSON_POOL_CAPACITY + 1; i++)
+      doc.add(i);
+
+    doc.reset();
+    auto stats = doc.stats();
+
+    REQUIRE(stats.slotsUsed == 0);
+    REQUIRE(stats.slotsFree == ARDUINOJSON_POOL_CAPACITY * 2);
+    REQUIRE(stats.poolCount == 2);
+    REQUIRE(stats.peakUsage == sizeofArray(ARDUINOJSON_POOL_CAPACITY + 1));
+  }
+
+  SECTION("clear() releases everything but keeps the cumulative counters") {
+    doc.add("hello"_s);
+    doc.add("hello"_s);
+
+    doc.clear();
+    auto stats = doc.stats();
+
+    REQUIRE(stats.slotsUsed == 0);
+    REQUIRE(stats.slotsFree == 0);
+    REQUIRE(stats.poolCount == 0);
+    REQUIRE(stats.stringCount == 0);
+    REQUIRE(stats.stringBytes == 0);
+    REQUIRE(stats.dedupHits == 1);
+    REQUIRE(stats.allocatorCalls == 4);  // pool + string, then release them
+    REQUIRE(stats.peakUsage == sizeofArray(2) + sizeofString(5));
+  }
+
+  SECTION("compact() keeps the cumulative counters") {
+    doc.add("hello"_s);
+    doc.add("hello"_s);
+    doc.remove(1);
+    spy.clearLog();
+
+    doc.compact();
+    auto stats = doc.stats();
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Allocate(sizeofString("hello")),
+                             Deallocate(sizeofPool()),
+                             Deallocate(sizeofString("hello")),
+                             Reallocate(sizeofPool(), sizeofPool(1)),
+                         });
+    REQUIRE(stats.dedupHits == 1);
+    REQUIRE(stats.allocatorCalls == 2 + 5);
+    REQUIRE(stats.allocatedBytes == 2 * (sizeofPool() + sizeofString(5)) +
+                                        sizeofPool(1));
+    REQUIRE(stats.peakUsage == sizeofArray(2) + sizeofString(5));
+  }
+}
@@ -0,0 +1,110 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+#include "Literals.hpp"
+
+using ArduinoJson::detail::sizeofObject;
+
+TEST_CASE("JsonDocument::useStringArena()") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+  doc.useStringArena();
+
+  SECTION("allocates the strings in a chunk") {
+    doc["hello"_s] = "world"_s;
+    doc["key"_s] = "value"_s;
+
+    REQUIRE(doc.as<std::string>() == "{\"hello\":\"world\",\"key\":\"value\"}");
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Allocate(sizeofStringChunk()),
+                         });
+  }
+
+  SECTION("doubles the size of the chunks") {
+    doc.add(std::string(200, 'a'));
+    doc.add(std::string(200, 'b'));
+
+    REQUIRE(doc[0] == std::string(200, 'a'));
+    REQUIRE(doc[1] == std::string(200, 'b'));
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Allocate(sizeofStringChunk(256)),
+                             Allocate(sizeofStringChunk(512)),
+                         });
+  }
+
+  SECTION("removing a string doesn't call the allocator") {
+    doc["hello"_s] = "world"_s;
+    spy.clearLog();
+
+    doc.remove("hello"_s);
+
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("deserializeJson()") {
+    deserializeJson(doc, "{\"hello\":\"world\",\"key\":\"value\"}");
+
+    REQUIRE(doc.as<std::string>() == "{\"hello\":\"world\",\"key\":\"value\"}");
+    REQUIRE(spy.log() ==
+            AllocatorLog{
+                Allocate(sizeofStringChunk()),
+                Allocate(sizeofPool()),
+                Reallocate(sizeofPool(), sizeofObject(2)),  // auto shrink
+            });
+  }
+
+  SECTION("clear() releases the chunks") {
+    doc["hello"_s] = "world"_s;
+    spy.clearLog();
+
+    doc.clear();
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofPool()),
+                             Deallocate(sizeofStringChunk()),
+                         });
+  }
+
+  SECTION("reset() reuses the chunks") {
+    doc["hello"_s] = "world"_s;
+    spy.clearLog();
+
+    doc.reset();
+    doc["key"_s] = "value"_s;
+
+    REQUIRE(doc.as<std::string>() == "{\"key\":\"value\"}");
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("shrinkToFit() releases the empty chunks") {
+    doc["hello"_s] = "world"_s;
+    doc.reset();
+    spy.clearLog();
+
+    doc.shrinkToFit();
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofPool()),
+                             Deallocate(sizeofStringChunk()),
+                         });
+  }
+
+  SECTION("useStringArena(false) goes back to the allocator") {
+    doc.useStringArena(false);
+
+    doc.set("hello"_s);
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofString("hello")),
+                         });
+  }
+}
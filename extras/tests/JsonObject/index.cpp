@@ -0,0 +1,106 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+#include "Allocators.hpp"
+
+static std::string key(int i) {
+  return "key" + std::to_string(i);
+}
+
+TEST_CASE("JsonObject with many members") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+  JsonObject obj = doc.to<JsonObject>();
+  for (int i = 0; i < 100; i++)
+    obj[key(i)] = i;
+
+  SECTION("finds all members") {
+    for (int i = 0; i < 100; i++)
+      REQUIRE(obj[key(i)] == i);
+    REQUIRE(obj["unknown"].isNull());
+  }
+
+  SECTION("finds members added after the index was built") {
+    REQUIRE(obj[key(99)] == 99);
+    for (int i = 100; i < 200; i++)
+      obj[key(i)] = i;
+    for (int i = 0; i < 200; i++)
+      REQUIRE(obj[key(i)] == i);
+    REQUIRE(obj.size() == 200);
+  }
+
+  SECTION("lookups don't allocate, so threads can share the object") {
+    spy.clearLog();
+    JsonObjectConst constObj = obj;
+    for (int i = 0; i < 100; i++)
+      REQUIRE(constObj[key(i)] == i);
+    REQUIRE(constObj["unknown"].isNull());
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("doesn't duplicate keys") {
+    for (int i = 0; i < 100; i++)
+      obj[key(i)] = -i;
+    REQUIRE(obj.size() == 100);
+    REQUIRE(obj[key(42)] == -42);
+  }
+
+  SECTION("remove()") {
+    REQUIRE(obj[key(99)] == 99);
+
+    SECTION("remove first member") {
+      obj.remove(key(0));
+      REQUIRE(obj[key(0)].isNull());
+      REQUIRE(obj[key(1)] == 1);
+      REQUIRE(obj.size() == 99);
+    }
+
+    SECTION("remove every other member") {
+      for (int i = 0; i < 100; i += 2)
+        obj.remove(key(i));
+      for (int i = 0; i < 100; i++) {
+        if (i % 2)
+          REQUIRE(obj[key(i)] == i);
+        else
+          REQUIRE(obj[key(i)].isNull());
+      }
+      REQUIRE(obj.size() == 50);
+    }
+
+    SECTION("remove all members") {
+      for (int i = 0; i < 100; i++)
+        obj.remove(key(i));
+      REQUIRE(obj.size() == 0);
+      obj["hello"] = "world";
+      REQUIRE(obj["hello"] == "world");
+    }
+  }
+
+  SECTION("clear() releases the index") {
+    REQUIRE(obj[key(99)] == 99);
+    obj.clear();
+    REQUIRE(obj.size() == 0);
+    REQUIRE(obj[key(99)].isNull());
+    doc.clear();
+    REQUIRE(spy.allocatedBytes() == 0);
+  }
+
+  SECTION("deserializeJson() keeps the last value of duplicate keys") {
+    std::string json = "{";
+    for (int i = 0; i < 100; i++)
+      json += "\"" + key(i) + "\":" + std::to_string(i) + ",";
+    json += "\"" + key(50) + "\":-1}";
+
+    DeserializationError err = deserializeJson(doc, json);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.size() == 100);
+    REQUIRE(doc[key(50)] == -1);
+    REQUIRE(doc[key(99)] == 99);
+  }
+}
@@ -57,6 +57,29 @@ TEST_CASE("JsonObject::remove()") {
       serializeJson(obj, result);
       REQUIRE("{\"a\":0,\"b\":1}" == result);
     }
+
+    SECTION("Returns the next member") {
+      it = obj.remove(it);
+      REQUIRE(it->key() == "b");
+      it = obj.remove(it);
+      REQUIRE(it->key() == "c");
+      it = obj.remove(it);
+      REQUIRE(it == obj.end());
+      REQUIRE(obj.size() == 0);
+    }
+
+    SECTION("In a loop") {
+      obj["d"] = 3;
+      obj["e"] = 4;
+      while (it != obj.end()) {
+        if (it->value().as<int>() != 2)
+          it = obj.remove(it);
+        else
+          ++it;
+      }
+      serializeJson(obj, result);
+      REQUIRE("{\"c\":2}" == result);
+    }
   }
 
 #ifdef HAS_VARIABLE_LENGTH_ARRAY
@@ -78,7 +101,8 @@ TEST_CASE("JsonObject::remove()") {
 
   SECTION("remove by iterator on unbound reference") {
     JsonObject unboundObject;
-    unboundObject.remove(unboundObject.begin());
+    REQUIRE(unboundObject.remove(unboundObject.begin()) ==
+            unboundObject.end());
   }
 
   SECTION("remove(JsonVariant)") {
@@ -0,0 +1,76 @@
+#define ARDUINOJSON_VERSION_NAMESPACE CachedCollectionSize
+#define ARDUINOJSON_CACHE_COLLECTION_SIZE 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_CACHE_COLLECTION_SIZE == 1") {
+  JsonDocument doc;
+
+  SECTION("JsonArray") {
+    JsonArray array = doc.to<JsonArray>();
+    REQUIRE(array.size() == 0);
+
+    array.add(1);
+    array.add(2);
+    array.add(3);
+    REQUIRE(array.size() == 3);
+
+    array.remove(1);
+    REQUIRE(array.size() == 2);
+
+    array.remove(array.begin());
+    REQUIRE(array.size() == 1);
+
+    array.clear();
+    REQUIRE(array.size() == 0);
+  }
+
+  SECTION("JsonObject") {
+    JsonObject obj = doc.to<JsonObject>();
+    REQUIRE(obj.size() == 0);
+
+    obj["a"] = 1;
+    obj["b"] = 2;
+    obj["c"] = 3;
+    obj["a"] = 4;
+    REQUIRE(obj.size() == 3);
+
+    obj.remove("b");
+    REQUIRE(obj.size() == 2);
+
+    obj.remove(obj.begin());
+    REQUIRE(obj.size() == 1);
+
+    obj.clear();
+    REQUIRE(obj.size() == 0);
+  }
+
+  SECTION("deserializeJson()") {
+    deserializeJson(doc, "{\"a\":[1,2,3],\"b\":{\"c\":1,\"d\":2}}");
+
+    REQUIRE(doc.size() == 2);
+    REQUIRE(doc["a"].size() == 3);
+    REQUIRE(doc["b"].size() == 2);
+  }
+
+  SECTION("deserializeMsgPack()") {
+    deserializeMsgPack(doc, "\x82\xA1\x61\x93\x01\x02\x03\xA1\x62\x90");
+
+    REQUIRE(doc.size() == 2);
+    REQUIRE(doc["a"].size() == 3);
+    REQUIRE(doc["b"].size() == 0);
+  }
+
+  SECTION("serializeMsgPack()") {
+    doc["a"].add(1);
+    doc["a"].add(2);
+    doc["b"]["c"] = 3;
+
+    std::string result;
+    serializeMsgPack(doc, result);
+
+    REQUIRE(result == "\x82\xA1\x61\x92\x01\x02\xA1\x62\x81\xA1\x63\x03");
+  }
+}
@@ -0,0 +1,36 @@
+#define ARDUINOJSON_VERSION_NAMESPACE NoStats
+#define ARDUINOJSON_ENABLE_STATS 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+#include "Allocators.hpp"
+
+using ArduinoJson::detail::sizeofString;
+
+TEST_CASE("ARDUINOJSON_ENABLE_STATS == 0") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("the allocator is called directly") {
+    CHECK(doc.allocator() == &spy);
+
+    doc[std::string("hello")] = std::string("world");
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Allocate(sizeofString("hello")),
+                             Allocate(sizeofString("world")),
+                         });
+  }
+
+  SECTION("compact() keeps the content") {
+    doc["a"] = "hello";
+    doc["b"] = "world";
+    doc.remove("a");
+
+    REQUIRE(doc.compact() == true);
+
+    REQUIRE(doc.as<std::string>() == "{\"b\":\"world\"}");
+  }
+}
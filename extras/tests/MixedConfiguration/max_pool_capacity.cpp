@@ -0,0 +1,30 @@
+#define ARDUINOJSON_VERSION_NAMESPACE GrowingPools
+#define ARDUINOJSON_POOL_CAPACITY 16
+#define ARDUINOJSON_MAX_POOL_CAPACITY 64
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+#include "Allocators.hpp"
+
+TEST_CASE("ARDUINOJSON_MAX_POOL_CAPACITY == 64") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  for (int i = 0; i < 150; i++)
+    doc.add(i);
+
+  REQUIRE(spy.log() == AllocatorLog{
+                           Allocate(sizeofPool(16)),
+                           Allocate(sizeofPool(32)),
+                           Allocate(sizeofIndexMap()),
+                           GrowArrayIndex(0, 3),
+                           Allocate(sizeofPool(64)),
+                           GrowArrayIndex(3, 4),
+                           Allocate(sizeofPool(64)),
+                           GrowArrayIndex(4, 5),
+                       });
+
+  for (int i = 0; i < 150; i++)
+    REQUIRE(doc[i] == i);
+}
@@ -0,0 +1,44 @@
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define ARDUINOJSON_USE_SSE2 1
+#endif
+#define ARDUINOJSON_VERSION_NAMESPACE UseSse2
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+#include <string>
+
+#if ARDUINOJSON_USE_SSE2
+TEST_CASE("ARDUINOJSON_USE_SSE2 == 1") {
+  using namespace ArduinoJson::detail;
+
+  SECTION("classifyCharsSse2() agrees with classifyCharsScalar()") {
+    const char chars[] = "a\"\\{}[]:,'/\0 \x7f\xff\x5b\x5d\x7b";
+    std::string block;
+    for (size_t i = 0; i < 64; i++)
+      block += chars[i % (sizeof(chars) - 1)];
+
+    CharMasks expected, actual;
+    classifyCharsScalar(block.c_str(), expected);
+    classifyCharsSse2(block.c_str(), actual);
+
+    REQUIRE(actual.quotes == expected.quotes);
+    REQUIRE(actual.backslashes == expected.backslashes);
+    REQUIRE(actual.structurals == expected.structurals);
+    REQUIRE(actual.unsupported == expected.unsupported);
+    REQUIRE(actual.nulls == expected.nulls);
+  }
+
+  SECTION("deserializeJsonIndexed()") {
+    JsonDocument doc;
+    std::string input = "[\"" + std::string(70, ' ') + "\\\"\",{\"a\":[1]}]";
+
+    DeserializationError err = deserializeJsonIndexed(doc, input.c_str());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == std::string(70, ' ') + "\"");
+    REQUIRE(doc[1]["a"][0] == 1);
+  }
+}
+#endif
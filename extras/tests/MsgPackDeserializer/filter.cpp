@@ -1536,6 +1536,23 @@ TEST_CASE("Zero-copy mode") {  // issue #1697
   CHECK(doc.as<std::string>() == "{\"include\":1}");
 }
 
+TEST_CASE("deserializeMsgPack() with a CompiledFilter") {
+  JsonDocument filter;
+  filter["include"] = true;
+  filter["list"][0]["id"] = true;
+  CompiledFilter compiledFilter(filter);
+
+  JsonDocument doc;
+  DeserializationError err = deserializeMsgPack(
+      doc,
+      "\x83\xA7include\x01\xA6ignore\x02"
+      "\xA4list\x92\x82\xA2id\x01\xA1x\x02\x81\xA1x\x03",
+      36, compiledFilter.filter());
+
+  CHECK(err == DeserializationError::Ok);
+  CHECK(doc.as<std::string>() == "{\"include\":1,\"list\":[{\"id\":1},{}]}");
+}
+
 TEST_CASE("Overloads") {
   JsonDocument doc;
   JsonDocument filter;
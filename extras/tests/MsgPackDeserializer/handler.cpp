@@ -0,0 +1,71 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "Literals.hpp"
+#include "LoggingHandler.hpp"
+
+TEST_CASE("deserializeMsgPack(JsonHandler&)") {
+  LoggingHandler handler;
+
+  SECTION("sends the values in order") {
+    DeserializationError err =
+        deserializeMsgPack(handler,
+                           "\x82\xa1\x61\x96\x01\xfe\xca\x40\x60\x00\x00"
+                           "\xc3\xc2\xc0\xa1\x62\x80"_s);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(handler.str() ==
+            "{ key:a [ int:1 int:-2 float:3.5 true false null ] key:b { } }");
+  }
+
+  SECTION("integers") {
+    DeserializationError err =
+        deserializeMsgPack(handler,
+                           "\x93\xcc\xff\xd1\xff\x00"
+                           "\xcb\x40\x09\x21\xfb\x54\x44\x2d\x18"_s);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(handler.str() == "[ uint:255 int:-256 float:3.14159 ]");
+  }
+
+  SECTION("strings") {
+    DeserializationError err = deserializeMsgPack(
+        handler, "\x92\xa5hello\xd9\x05world"_s);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(handler.str() == "[ string:hello string:world ]");
+  }
+
+  SECTION("binaries and extensions") {
+    DeserializationError err =
+        deserializeMsgPack(handler, "\x92\xc4\x02\x01\x02\xd4\x01\x02"_s);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(handler.str() == "[ raw:4 raw:3 ]");
+  }
+
+  SECTION("NestingLimit") {
+    DeserializationError err = deserializeMsgPack(
+        handler, "\x91\x90", DeserializationOption::NestingLimit(1));
+
+    REQUIRE(err == DeserializationError::TooDeep);
+    REQUIRE(handler.str() == "[");
+  }
+
+  SECTION("EmptyInput") {
+    DeserializationError err = deserializeMsgPack(handler, "", 0);
+
+    REQUIRE(err == DeserializationError::EmptyInput);
+  }
+
+  SECTION("IncompleteInput") {
+    DeserializationError err = deserializeMsgPack(handler, "\x92\x01"_s);
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+    REQUIRE(handler.str() == "[ int:1");
+  }
+}
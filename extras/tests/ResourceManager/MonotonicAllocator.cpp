@@ -0,0 +1,130 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+#include "Allocators.hpp"
+
+using ArduinoJson::detail::isAligned;
+
+TEST_CASE("MonotonicAllocator") {
+  char buffer[256];
+  MonotonicAllocator allocator(buffer, sizeof(buffer));
+
+  SECTION("allocates in the buffer") {
+    auto a = allocator.allocate(10);
+    auto b = allocator.allocate(10);
+
+    REQUIRE(a >= buffer);
+    REQUIRE(b >= buffer);
+    REQUIRE(b > a);
+    REQUIRE(static_cast<char*>(b) < buffer + sizeof(buffer));
+    REQUIRE(isAligned(a));
+    REQUIRE(isAligned(b));
+  }
+
+  SECTION("returns null when the buffer is full") {
+    REQUIRE(allocator.allocate(sizeof(buffer)) == nullptr);
+  }
+
+  SECTION("recycles the last block") {
+    auto a = allocator.allocate(10);
+    auto size = allocator.size();
+    auto b = allocator.allocate(10);
+    allocator.deallocate(b);
+
+    REQUIRE(allocator.size() == size);
+    REQUIRE(allocator.allocate(10) == b);
+    (void)a;
+  }
+
+  SECTION("recycles the buffer when all blocks are released") {
+    auto a = allocator.allocate(10);
+    auto b = allocator.allocate(10);
+    allocator.deallocate(a);
+    allocator.deallocate(b);
+
+    REQUIRE(allocator.size() == 0);
+  }
+
+  SECTION("extends the last block in place") {
+    auto a = static_cast<char*>(allocator.allocate(4));
+    strcpy(a, "abc");
+    auto b = allocator.reallocate(a, 100);
+
+    REQUIRE(b == a);
+    REQUIRE(a == std::string("abc"));
+  }
+
+  SECTION("moves the other blocks") {
+    auto a = static_cast<char*>(allocator.allocate(4));
+    strcpy(a, "abc");
+    allocator.allocate(4);
+    auto b = static_cast<char*>(allocator.reallocate(a, 100));
+
+    REQUIRE(b > a);
+    REQUIRE(b == std::string("abc"));
+  }
+}
+
+TEST_CASE("MonotonicAllocator with upstream") {
+  char buffer[64];
+  SpyingAllocator spy;
+  MonotonicAllocator allocator(buffer, sizeof(buffer), &spy);
+
+  SECTION("forwards requests when the buffer is full") {
+    auto a = allocator.allocate(100);
+    a = allocator.reallocate(a, 200);
+    allocator.deallocate(a);
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(100),
+                             Reallocate(100, 200),
+                             Deallocate(200),
+                         });
+  }
+
+  SECTION("moves the last block to upstream when it can't grow") {
+    auto a = static_cast<char*>(allocator.allocate(8));
+    strcpy(a, "abcdefg");
+    auto b = static_cast<char*>(allocator.reallocate(a, 100));
+
+    REQUIRE(b == std::string("abcdefg"));
+    REQUIRE(allocator.size() == 0);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(100),
+                         });
+    allocator.deallocate(b);
+  }
+}
+
+TEST_CASE("JsonDocument with a MonotonicAllocator") {
+  char buffer[4096];
+  SpyingAllocator spy;
+  MonotonicAllocator allocator(buffer, sizeof(buffer), &spy);
+  JsonDocument doc(&allocator);
+
+  deserializeJson(doc, "{\"hello\":[\"world\",42]}");
+
+  REQUIRE(doc["hello"][0] == "world");
+  REQUIRE(doc["hello"][1] == 42);
+  REQUIRE(allocator.size() > 0);
+  REQUIRE(spy.log() == AllocatorLog{});
+
+  SECTION("clear() releases the whole buffer") {
+    doc.clear();
+
+    REQUIRE(allocator.size() == 0);
+  }
+
+  SECTION("the document can be reused after clear()") {
+    doc.clear();
+    deserializeJson(doc, "[1,2,3]");
+
+    REQUIRE(doc.as<std::string>() == "[1,2,3]");
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+}
@@ -55,6 +55,43 @@ TEST_CASE("StringBuilder") {
     REQUIRE(str.isValid() == true);
     REQUIRE(str.str() == lorem);
     REQUIRE(resources.overflowed() == false);
+    REQUIRE(spyingAllocator.log() ==
+            AllocatorLog{
+                Allocate(sizeofStringBuffer()),
+                Reallocate(sizeofStringBuffer(), sizeofString(lorem)),
+            });
+  }
+
+  SECTION("Appending characters doubles the capacity") {
+    StringBuilder str(&resources);
+    const char* lorem =
+        "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do "
+        "eiusmod tempor incididunt ut labore et dolore magna aliqua.";
+
+    str.startString();
+    for (const char* p = lorem; *p; p++)
+      str.append(*p);
+
+    REQUIRE(str.isValid() == true);
+    REQUIRE(str.str() == lorem);
+    REQUIRE(resources.overflowed() == false);
+    REQUIRE(spyingAllocator.log() ==
+            AllocatorLog{
+                Allocate(sizeofStringBuffer(1)),
+                Reallocate(sizeofStringBuffer(1), sizeofStringBuffer(2)),
+                Reallocate(sizeofStringBuffer(2), sizeofStringBuffer(3)),
+            });
+  }
+
+  SECTION("Appending short strings doubles the capacity") {
+    StringBuilder str(&resources);
+
+    str.startString();
+    for (int i = 0; i < 10; i++)
+      str.append("0123456789", 10);
+
+    REQUIRE(str.isValid() == true);
+    REQUIRE(str.size() == 100);
     REQUIRE(spyingAllocator.log() ==
             AllocatorLog{
                 Allocate(sizeofStringBuffer(1)),
@@ -75,7 +112,7 @@ TEST_CASE("StringBuilder") {
     REQUIRE(spyingAllocator.log() ==
             AllocatorLog{
                 Allocate(sizeofStringBuffer()),
-                ReallocateFail(sizeofStringBuffer(), sizeofStringBuffer(2)),
+                ReallocateFail(sizeofStringBuffer(), sizeofString(123)),
                 Deallocate(sizeofStringBuffer()),
             });
     REQUIRE(str.isValid() == false);
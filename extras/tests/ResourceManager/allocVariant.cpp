@@ -89,4 +89,34 @@ TEST_CASE("ResourceManager::allocVariant()") {
 
     REQUIRE(resources.overflowed() == true);
   }
+
+  SECTION("Pools grow up to the max pool capacity") {
+    SpyingAllocator spy;
+    ResourceManager resources(&spy);
+    REQUIRE(resources.setMaxPoolCapacity(64) == true);
+
+    // fill all the pools
+    for (SlotId i = 0; i < NULL_SLOT; i++) {
+      auto slot = resources.allocVariant();
+      REQUIRE(slot.id() == i);
+      REQUIRE(resources.getVariant(i) == slot.ptr());
+    }
+
+    REQUIRE(resources.allocVariant().ptr() == nullptr);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool(16)),
+                             Allocate(sizeofPool(32)),
+                             Allocate(sizeofPool(64)) * 2,
+                             Allocate(sizeofPoolList(8)),
+                             Allocate(sizeofPool(64)),
+                             Allocate(sizeofPool(15)),
+                         });
+  }
+
+  SECTION("Can't change the max pool capacity once the pools exist") {
+    ResourceManager resources;
+    resources.allocVariant();
+
+    REQUIRE(resources.setMaxPoolCapacity(64) == false);
+  }
 }
@@ -63,6 +63,40 @@ TEST_CASE("ResourceManager::saveString()") {
             sizeofString("hello") + sizeofString("hello world"));
   }
 
+  SECTION("Deduplicates strings when the pool is indexed") {
+    char key[16];
+    StringNode* nodes[64];
+    for (int i = 0; i < 64; i++) {
+      snprintf(key, sizeof(key), "key%02d", i);
+      nodes[i] = saveString(resources, key);
+    }
+    for (int i = 0; i < 64; i++) {
+      snprintf(key, sizeof(key), "key%02d", i);
+      REQUIRE(saveString(resources, key) == nodes[i]);
+      REQUIRE(nodes[i]->references == 2);
+    }
+  }
+
+  SECTION("Releases strings when the pool is indexed") {
+    char key[16];
+    StringNode* nodes[64];
+    for (int i = 0; i < 64; i++) {
+      snprintf(key, sizeof(key), "key%02d", i);
+      nodes[i] = saveString(resources, key);
+    }
+    for (int i = 0; i < 64; i += 2)
+      resources.dereferenceString(nodes[i]->data);
+    REQUIRE(resources.size() == 32 * sizeofString("key10"));
+    for (int i = 1; i < 64; i += 2) {
+      snprintf(key, sizeof(key), "key%02d", i);
+      REQUIRE(resources.getString(adaptString(key)) == nodes[i]);
+    }
+    for (int i = 0; i < 64; i += 2) {
+      snprintf(key, sizeof(key), "key%02d", i);
+      REQUIRE(resources.getString(adaptString(key)) == nullptr);
+    }
+  }
+
   SECTION("Returns NULL when allocation fails") {
     ResourceManager pool2(FailingAllocator::instance());
     REQUIRE(saveString(pool2, "a") == nullptr);
@@ -0,0 +1,171 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_ENABLE_STD_THREAD 1
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+
+// Counts the blocks, from several threads
+class ThreadSafeCountingAllocator : public ArduinoJson::Allocator {
+ public:
+  virtual ~ThreadSafeCountingAllocator() {}
+
+  void* allocate(size_t n) override {
+    blocks_++;
+    return malloc(n);
+  }
+
+  void deallocate(void* p) override {
+    blocks_--;
+    free(p);
+  }
+
+  void* reallocate(void* p, size_t n) override {
+    if (!p)
+      blocks_++;
+    return realloc(p, n);
+  }
+
+  int blocks() const {
+    return blocks_;
+  }
+
+ private:
+  std::atomic<int> blocks_{0};
+};
+
+static void checkSameAsSerial(const std::string& input, size_t threadCount) {
+  JsonDocument expected, actual;
+
+  DeserializationError expectedErr = deserializeJson(expected, input);
+  DeserializationError actualErr = deserializeJsonParallel(
+      actual, input.c_str(), input.size(), threadCount);
+
+  CAPTURE(input);
+  CAPTURE(threadCount);
+  REQUIRE(actualErr == expectedErr);
+  REQUIRE(actual.as<std::string>() == expected.as<std::string>());
+  REQUIRE(actual.stats().stringCount == expected.stats().stringCount);
+  REQUIRE(actual.stats().stringBytes == expected.stats().stringBytes);
+}
+
+TEST_CASE("deserializeJsonParallel()") {
+  SECTION("gives the same result as deserializeJson()") {
+    std::string input = "[";
+    for (int i = 0; i < 1000; i++) {
+      if (i)
+        input += ",\n";
+      input += "{\"id\":" + std::to_string(i) +
+               ",\"name\":\"item, \\\"" + std::to_string(i) +
+               "\\\" ]\",'tags':[\"a\",{\"b\":[1.5,true,null]}]}";
+    }
+    input += "]";
+
+    for (size_t threadCount = 1; threadCount <= 8; threadCount++)
+      checkSameAsSerial(input, threadCount);
+  }
+
+  SECTION("large collections and 64-bit values") {
+    std::string input = "[";
+    for (int i = 0; i < 200; i++) {
+      if (i)
+        input += ",";
+      input += "[" + std::to_string(i) + ",1e300,-9007199254740993,{";
+      for (int j = 0; j < 20; j++) {
+        if (j)
+          input += ",";
+        input += "\"k" + std::to_string(j) + "\":" + std::to_string(j);
+      }
+      input += "}]";
+    }
+    input += "]";
+
+    checkSameAsSerial(input, 4);
+
+    JsonDocument doc;
+    deserializeJsonParallel(doc, input.c_str(), input.size(), 4);
+
+    REQUIRE(doc[150][0] == 150);
+    REQUIRE(doc[150][1] == 1e300);
+    REQUIRE(doc[150][2] == -9007199254740993LL);
+    REQUIRE(doc[150][3]["k19"] == 19);
+  }
+
+  SECTION("uses the allocator of the document") {
+    std::string input = "[";
+    for (int i = 0; i < 1000; i++) {
+      if (i)
+        input += ",";
+      input += "[\"same\",\"s" + std::to_string(i) + "\"]";
+    }
+    input += "]";
+    ThreadSafeCountingAllocator allocator;
+
+    {
+      JsonDocument doc(&allocator);
+      DeserializationError err =
+          deserializeJsonParallel(doc, input.c_str(), input.size(), 4);
+
+      REQUIRE(err == DeserializationError::Ok);
+      REQUIRE(doc[999][1] == "s999");
+      REQUIRE(allocator.blocks() > 0);
+    }
+
+    REQUIRE(allocator.blocks() == 0);
+  }
+
+  SECTION("falls back to deserializeJson() when the pools can grow") {
+    JsonDocument doc;
+    doc.setMaxPoolCapacity(4096);
+
+    DeserializationError err = deserializeJsonParallel(doc, "[1,2,3]", 7, 4);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[1,2,3]");
+  }
+
+  SECTION("small arrays") {
+    checkSameAsSerial("[]", 4);
+    checkSameAsSerial("[1]", 4);
+    checkSameAsSerial(" [1,2,3] ", 4);
+    checkSameAsSerial("[1,2,3]trailing", 4);
+  }
+
+  SECTION("inputs that are not arrays") {
+    checkSameAsSerial("{\"a\":[1,2,3]}", 4);
+    checkSameAsSerial("\"[1,2,3]\"", 4);
+    checkSameAsSerial("42", 4);
+    checkSameAsSerial("", 4);
+  }
+
+  SECTION("errors") {
+    checkSameAsSerial("[1,2,3", 4);
+    checkSameAsSerial("[1,2,,3]", 4);
+    checkSameAsSerial("[1,2,3,]", 4);
+    checkSameAsSerial("[\"a\",\"b\",\"c", 4);
+    checkSameAsSerial("[1,2,{\"a\":}]", 4);
+  }
+
+  SECTION("filter and nesting limit") {
+    JsonDocument filter;
+    filter[0]["id"] = true;
+    const char* input = "[{\"id\":1,\"x\":2},{\"id\":3,\"x\":[4]},{\"id\":5}]";
+    JsonDocument doc;
+
+    DeserializationError err = deserializeJsonParallel(
+        doc, input, strlen(input), 3, DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[{\"id\":1},{\"id\":3},{\"id\":5}]");
+
+    err = deserializeJsonParallel(doc, input, strlen(input), 3,
+                                  DeserializationOption::NestingLimit(2));
+
+    REQUIRE(err == DeserializationError::TooDeep);
+  }
+}
@@ -30,7 +30,9 @@
 #include "ArduinoJson/Object/JsonObject.hpp"
 #include "ArduinoJson/Variant/JsonVariantConst.hpp"
 
+#include "ArduinoJson/Document/FrozenJsonDocument.hpp"
 #include "ArduinoJson/Document/JsonDocument.hpp"
+#include "ArduinoJson/Memory/MonotonicAllocator.hpp"
 
 #include "ArduinoJson/Array/ArrayImpl.hpp"
 #include "ArduinoJson/Array/ElementProxy.hpp"
@@ -45,8 +47,14 @@
 #include "ArduinoJson/Variant/VariantImpl.hpp"
 #include "ArduinoJson/Variant/VariantRefBaseImpl.hpp"
 
+#include "ArduinoJson/Deserialization/CompiledFilter.hpp"
+#include "ArduinoJson/Deserialization/StaticFilter.hpp"
 #include "ArduinoJson/Json/JsonDeserializer.hpp"
 #include "ArduinoJson/Json/JsonSerializer.hpp"
+#include "ArduinoJson/Json/JsonStreamParser.hpp"
+#include "ArduinoJson/Json/JsonStreamReader.hpp"
+#include "ArduinoJson/Json/deserializeJsonParallel.hpp"
+#include "ArduinoJson/Json/deserializeJsonIndexed.hpp"
 #include "ArduinoJson/Json/PrettyJsonSerializer.hpp"
 #include "ArduinoJson/MsgPack/MsgPackBinary.hpp"
 #include "ArduinoJson/MsgPack/MsgPackDeserializer.hpp"
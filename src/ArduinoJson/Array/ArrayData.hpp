@@ -8,6 +8,8 @@
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
+struct CollectionIndex;
+
 class ArrayData : public CollectionData {
  public:
   VariantData* addElement(ResourceManager* resources);
@@ -49,18 +51,33 @@ class ArrayData : public CollectionData {
     array->removeElement(index, resources);
   }
 
-  void remove(iterator it, ResourceManager* resources) {
-    CollectionData::removeOne(it, resources);
-  }
+  // Returns an iterator to the next element
+  iterator remove(iterator it, ResourceManager* resources);
 
-  static void remove(ArrayData* array, iterator it,
-                     ResourceManager* resources) {
-    if (array)
-      return array->remove(it, resources);
+  static iterator remove(ArrayData* array, iterator it,
+                         ResourceManager* resources) {
+    if (!array)
+      return iterator();
+    return array->remove(it, resources);
   }
 
+  // Creates the index of a large array that doesn't have one.
+  // The reads never create it, so concurrent reads are safe.
+  void buildIndex(ResourceManager* resources);
+
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  // Number of elements above which we build the index
+  static const size_t indexThreshold = 16;
+#endif
+
  private:
   iterator at(size_t index, const ResourceManager* resources) const;
+
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  CollectionIndex* getOrCreateIndex(ResourceManager* resources);
+  void addToIndex(SlotId id, ResourceManager* resources);
+  static void removeFromIndex(CollectionIndex* elements, size_t index);
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
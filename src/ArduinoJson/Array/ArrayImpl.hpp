@@ -12,6 +12,15 @@ ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 inline ArrayData::iterator ArrayData::at(
     size_t index, const ResourceManager* resources) const {
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  auto elements = resources->getCollectionIndex(head());
+  if (elements) {
+    if (index >= elements->count)
+      return iterator();
+    auto prevId = index > 0 ? elements->slots[index - 1] : NULL_SLOT;
+    return createIterator(elements->slots[index], prevId, resources);
+  }
+#endif
   auto it = createIterator(resources);
   while (!it.done() && index) {
     it.next(resources);
@@ -25,11 +34,31 @@ inline VariantData* ArrayData::addElement(ResourceManager* resources) {
   if (!slot)
     return nullptr;
   CollectionData::appendOne(slot, resources);
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  addToIndex(slot.id(), resources);
+#endif
   return slot.ptr();
 }
 
 inline VariantData* ArrayData::getOrAddElement(size_t index,
                                                ResourceManager* resources) {
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  if (index >= indexThreshold) {
+    auto elements = getOrCreateIndex(resources);
+    if (elements) {
+      if (index < elements->count)
+        return resources->getVariant(elements->slots[index]);
+      index -= elements->count;
+      VariantData* element;
+      do {
+        element = addElement(resources);
+        if (!element)
+          return nullptr;
+      } while (index-- > 0);
+      return element;
+    }
+  }
+#endif
   auto it = createIterator(resources);
   while (!it.done() && index > 0) {
     it.next(resources);
@@ -53,7 +82,30 @@ inline VariantData* ArrayData::getElement(
 }
 
 inline void ArrayData::removeElement(size_t index, ResourceManager* resources) {
-  remove(at(index, resources), resources);
+  auto it = at(index, resources);
+  if (it.done())
+    return;
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  auto elements = resources->getCollectionIndex(head());
+  if (elements)
+    removeFromIndex(elements, index);
+#endif
+  CollectionData::removeOne(it, resources);
+}
+
+inline ArrayData::iterator ArrayData::remove(iterator it,
+                                             ResourceManager* resources) {
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  auto elements = resources->getCollectionIndex(head());
+  if (elements && !it.done()) {
+    // we don't know the position of the element, so we look for its id
+    size_t index = 0;
+    while (index < elements->count && elements->slots[index] != it.id())
+      index++;
+    removeFromIndex(elements, index);
+  }
+#endif
+  return CollectionData::removeOne(it, resources);
 }
 
 template <typename T>
@@ -68,9 +120,68 @@ inline bool ArrayData::addValue(T&& value, ResourceManager* resources) {
     return false;
   }
   CollectionData::appendOne(slot, resources);
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  addToIndex(slot.id(), resources);
+#endif
   return true;
 }
 
+inline void ArrayData::buildIndex(ResourceManager* resources) {
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  if (size(resources) > indexThreshold)
+    getOrCreateIndex(resources);
+#else
+  (void)resources;
+#endif
+}
+
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+// The index is a contiguous array with the ids of the elements in order.
+
+inline CollectionIndex* ArrayData::getOrCreateIndex(
+    ResourceManager* resources) {
+  auto elements = resources->getCollectionIndex(head());
+  if (elements || head() == NULL_SLOT)
+    return elements;
+
+  elements = resources->createCollectionIndex(head());
+  if (!elements)
+    return nullptr;
+  if (!resources->resizeCollectionIndex(elements, size(resources))) {
+    resources->destroyCollectionIndex(head());
+    return nullptr;
+  }
+  for (auto it = createIterator(resources); !it.done(); it.next(resources))
+    elements->slots[elements->count++] = it.id();
+  return elements;
+}
+
+inline void ArrayData::addToIndex(SlotId id, ResourceManager* resources) {
+  auto elements = resources->getCollectionIndex(head());
+  if (!elements) {
+    // build the index when the array crosses the threshold
+    if (countSlots(indexThreshold + 2, resources) == indexThreshold + 1)
+      getOrCreateIndex(resources);
+    return;
+  }
+  if (elements->count == elements->capacity &&
+      !resources->resizeCollectionIndex(elements, elements->capacity * 2)) {
+    resources->destroyCollectionIndex(head());
+    return;
+  }
+  elements->slots[elements->count++] = id;
+}
+
+inline void ArrayData::removeFromIndex(CollectionIndex* elements,
+                                       size_t index) {
+  if (index >= elements->count)
+    return;
+  for (size_t i = index + 1; i < elements->count; i++)
+    elements->slots[i - 1] = elements->slots[i];
+  elements->count--;
+}
+#endif
+
 // Returns the size (in bytes) of an array with n elements.
 constexpr size_t sizeofArray(size_t n) {
   return n * ResourceManager::slotSize;
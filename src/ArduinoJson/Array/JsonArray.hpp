@@ -101,9 +101,11 @@ class JsonArray : public detail::VariantOperators<JsonArray> {
   }
 
   // Removes the element at the specified iterator.
+  // Returns an iterator to the next element.
   // https://arduinojson.org/v7/api/jsonarray/remove/
-  void remove(iterator it) const {
-    detail::ArrayData::remove(data_, it.iterator_, resources_);
+  iterator remove(iterator it) const {
+    return iterator(detail::ArrayData::remove(data_, it.iterator_, resources_),
+                    resources_);
   }
 
   // Removes the element at the specified index.
@@ -19,7 +19,11 @@ class CollectionIterator {
   friend class CollectionData;
 
  public:
-  CollectionIterator() : slot_(nullptr), currentId_(NULL_SLOT) {}
+  CollectionIterator()
+      : slot_(nullptr),
+        currentId_(NULL_SLOT),
+        prevId_(NULL_SLOT),
+        generation_(0) {}
 
   void next(const ResourceManager* resources);
 
@@ -27,6 +31,10 @@ class CollectionIterator {
     return slot_ == nullptr;
   }
 
+  SlotId id() const {
+    return currentId_;
+  }
+
   bool operator==(const CollectionIterator& other) const {
     return slot_ == other.slot_;
   }
@@ -59,15 +67,24 @@ class CollectionIterator {
   }
 
  private:
-  CollectionIterator(VariantData* slot, SlotId slotId);
+  CollectionIterator(VariantData* slot, SlotId slotId, SlotId prevId,
+                     size_t generation);
 
   VariantData* slot_;
   SlotId currentId_, nextId_;
+
+  // Allows removal in constant time, as long as no slot was released since the
+  // creation of the iterator (see ResourceManager::generation())
+  SlotId prevId_;
+  size_t generation_;
 };
 
 class CollectionData {
   SlotId head_ = NULL_SLOT;
   SlotId tail_ = NULL_SLOT;
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  SlotId size_ = 0;  // number of slots, i.e., twice the number of members
+#endif
 
  public:
   // Placement new
@@ -84,6 +101,9 @@ class CollectionData {
   size_t size(const ResourceManager*) const;
   size_t nesting(const ResourceManager*) const;
 
+  // Counts the slots, but stops at the limit
+  size_t countSlots(size_t limit, const ResourceManager*) const;
+
   void clear(ResourceManager* resources);
 
   static void clear(CollectionData* collection, ResourceManager* resources) {
@@ -96,16 +116,29 @@ class CollectionData {
     return head_;
   }
 
+  // Shifts the slot ids of a collection that was moved by
+  // ResourceManager::merge(), see VariantData::rebase()
+  void rebase(SlotId offset, ResourceManager* resources);
+
+  // Moves the slots of src at the end of this collection.
+  // Both must be in the same ResourceManager; the index of this collection is
+  // released, call buildIndex() to recreate it.
+  void splice(CollectionData& src, ResourceManager* resources);
+
  protected:
+  iterator createIterator(SlotId slotId, SlotId prevId,
+                          const ResourceManager* resources) const;
+
   void appendOne(Slot<VariantData> slot, const ResourceManager* resources);
   void appendPair(Slot<VariantData> key, Slot<VariantData> value,
                   const ResourceManager* resources);
 
-  void removeOne(iterator it, ResourceManager* resources);
-  void removePair(iterator it, ResourceManager* resources);
+  iterator removeOne(iterator it, ResourceManager* resources);
+  iterator removePair(iterator it, ResourceManager* resources);
 
  private:
-  Slot<VariantData> getPreviousSlot(VariantData*, const ResourceManager*) const;
+  Slot<VariantData> getPreviousSlot(const iterator&,
+                                    const ResourceManager*) const;
 };
 
 inline const VariantData* collectionToVariant(
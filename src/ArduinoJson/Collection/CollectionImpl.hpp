@@ -12,13 +12,18 @@
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
-inline CollectionIterator::CollectionIterator(VariantData* slot, SlotId slotId)
-    : slot_(slot), currentId_(slotId) {
+inline CollectionIterator::CollectionIterator(VariantData* slot, SlotId slotId,
+                                              SlotId prevId, size_t generation)
+    : slot_(slot),
+      currentId_(slotId),
+      prevId_(prevId),
+      generation_(generation) {
   nextId_ = slot_ ? slot_->next() : NULL_SLOT;
 }
 
 inline void CollectionIterator::next(const ResourceManager* resources) {
   ARDUINOJSON_ASSERT(currentId_ != NULL_SLOT);
+  prevId_ = currentId_;
   slot_ = resources->getVariant(nextId_);
   currentId_ = nextId_;
   if (slot_)
@@ -27,7 +32,13 @@ inline void CollectionIterator::next(const ResourceManager* resources) {
 
 inline CollectionData::iterator CollectionData::createIterator(
     const ResourceManager* resources) const {
-  return iterator(resources->getVariant(head_), head_);
+  return createIterator(head_, NULL_SLOT, resources);
+}
+
+inline CollectionData::iterator CollectionData::createIterator(
+    SlotId slotId, SlotId prevId, const ResourceManager* resources) const {
+  return iterator(resources->getVariant(slotId), slotId, prevId,
+                  resources->generation());
 }
 
 inline void CollectionData::appendOne(Slot<VariantData> slot,
@@ -40,6 +51,9 @@ inline void CollectionData::appendOne(Slot<VariantData> slot,
     head_ = slot.id();
     tail_ = slot.id();
   }
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  size_++;
+#endif
 }
 
 inline void CollectionData::appendPair(Slot<VariantData> key,
@@ -55,9 +69,17 @@ inline void CollectionData::appendPair(Slot<VariantData> key,
     head_ = key.id();
     tail_ = value.id();
   }
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  size_ += 2;
+#endif
 }
 
 inline void CollectionData::clear(ResourceManager* resources) {
+#if ARDUINOJSON_USE_COLLECTION_INDEX
+  if (head_ != NULL_SLOT)
+    resources->destroyCollectionIndex(head_);
+#endif
+
   auto next = head_;
   while (next != NULL_SLOT) {
     auto currId = next;
@@ -68,10 +90,63 @@ inline void CollectionData::clear(ResourceManager* resources) {
 
   head_ = NULL_SLOT;
   tail_ = NULL_SLOT;
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  size_ = 0;
+#endif
+}
+
+inline void CollectionData::rebase(SlotId offset, ResourceManager* resources) {
+  if (head_ == NULL_SLOT)
+    return;
+  head_ = SlotId(head_ + offset);
+  tail_ = SlotId(tail_ + offset);
+  for (auto id = head_; id != NULL_SLOT;) {
+    auto slot = resources->getVariant(id);
+    if (slot->next() != NULL_SLOT)
+      slot->setNext(SlotId(slot->next() + offset));
+    slot->rebase(offset, resources);
+    id = slot->next();
+  }
+}
+
+inline void CollectionData::splice(CollectionData& src,
+                                   ResourceManager* resources) {
+  if (src.head_ == NULL_SLOT)
+    return;
+#if ARDUINOJSON_USE_COLLECTION_INDEX
+  resources->destroyCollectionIndex(src.head_);
+#endif
+  if (tail_ != NULL_SLOT) {
+#if ARDUINOJSON_USE_COLLECTION_INDEX
+    resources->destroyCollectionIndex(head_);
+#endif
+    resources->getVariant(tail_)->setNext(src.head_);
+  } else {
+    head_ = src.head_;
+  }
+  tail_ = src.tail_;
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  size_ = SlotId(size_ + src.size_);
+  src.size_ = 0;
+#endif
+  src.head_ = NULL_SLOT;
+  src.tail_ = NULL_SLOT;
 }
 
 inline Slot<VariantData> CollectionData::getPreviousSlot(
-    VariantData* target, const ResourceManager* resources) const {
+    const iterator& it, const ResourceManager* resources) const {
+  if (it.currentId_ == head_)
+    return {};
+
+  // Trust the iterator if no slot was released since its creation
+  if (it.prevId_ != NULL_SLOT && it.generation_ == resources->generation()) {
+    auto prevSlot = resources->getVariant(it.prevId_);
+    ARDUINOJSON_ASSERT(prevSlot->next() == it.currentId_);
+    return {prevSlot, it.prevId_};
+  }
+
+  // Otherwise, walk the list
+  auto target = it.slot_;
   auto prev = Slot<VariantData>();
   auto currentId = head_;
   while (currentId != NULL_SLOT) {
@@ -84,25 +159,38 @@ inline Slot<VariantData> CollectionData::getPreviousSlot(
   return prev;
 }
 
-inline void CollectionData::removeOne(iterator it, ResourceManager* resources) {
+inline CollectionData::iterator CollectionData::removeOne(
+    iterator it, ResourceManager* resources) {
   if (it.done())
-    return;
+    return it;
   auto curr = it.slot_;
-  auto prev = getPreviousSlot(curr, resources);
+  auto prev = getPreviousSlot(it, resources);
   auto next = curr->next();
-  if (prev)
+  if (prev) {
     prev->setNext(next);
-  else
+  } else {
     head_ = next;
+#if ARDUINOJSON_USE_COLLECTION_INDEX
+    // the index is attached to the first slot
+    if (next != NULL_SLOT)
+      resources->moveCollectionIndex(it.currentId_, next);
+    else
+      resources->destroyCollectionIndex(it.currentId_);
+#endif
+  }
   if (next == NULL_SLOT)
     tail_ = prev.id();
   resources->freeVariant({it.slot_, it.currentId_});
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  size_--;
+#endif
+  return createIterator(next, prev.id(), resources);
 }
 
-inline void CollectionData::removePair(ObjectData::iterator it,
-                                       ResourceManager* resources) {
+inline CollectionData::iterator CollectionData::removePair(
+    ObjectData::iterator it, ResourceManager* resources) {
   if (it.done())
-    return;
+    return it;
 
   auto keySlot = it.slot_;
 
@@ -110,11 +198,17 @@ inline void CollectionData::removePair(ObjectData::iterator it,
   auto valueSlot = resources->getVariant(valueId);
 
   // remove value slot
+  auto upToDate = it.generation_ == resources->generation();
   keySlot->setNext(valueSlot->next());
   resources->freeVariant({valueSlot, valueId});
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  size_--;
+#endif
+  if (upToDate)  // the value was not the previous slot
+    it.generation_ = resources->generation();
 
   // remove key slot
-  removeOne(it, resources);
+  return removeOne(it, resources);
 }
 
 inline size_t CollectionData::nesting(const ResourceManager* resources) const {
@@ -128,10 +222,29 @@ inline size_t CollectionData::nesting(const ResourceManager* resources) const {
 }
 
 inline size_t CollectionData::size(const ResourceManager* resources) const {
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  (void)resources;
+  return size_;
+#else
   size_t count = 0;
   for (auto it = createIterator(resources); !it.done(); it.next(resources))
     count++;
   return count;
+#endif
+}
+
+inline size_t CollectionData::countSlots(
+    size_t limit, const ResourceManager* resources) const {
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  (void)resources;
+  return size_ < limit ? size_ : limit;
+#else
+  size_t count = 0;
+  for (auto it = createIterator(resources); !it.done() && count < limit;
+       it.next(resources))
+    count++;
+  return count;
+#endif
 }
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
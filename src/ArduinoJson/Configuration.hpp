@@ -56,6 +56,19 @@
 #  endif
 #endif
 
+// Support std::thread, to parse large arrays with deserializeJsonParallel()
+// Disabled by default because it requires linking with the thread library
+#ifndef ARDUINOJSON_ENABLE_STD_THREAD
+#  define ARDUINOJSON_ENABLE_STD_THREAD 0
+#endif
+
+// Use SSE2 instructions to find the structural characters in
+// deserializeJsonIndexed()
+// Disabled by default because it requires a CPU that supports SSE2
+#ifndef ARDUINOJSON_USE_SSE2
+#  define ARDUINOJSON_USE_SSE2 0
+#endif
+
 // Pointer size: a heuristic to set sensible defaults
 #ifndef ARDUINOJSON_SIZEOF_POINTER
 #  if defined(__SIZEOF_POINTER__)
@@ -119,6 +132,13 @@
 #  endif
 #endif
 
+// Maximum capacity of the variant pools (in slots)
+// Each pool is twice as big as the previous one, starting from
+// ARDUINOJSON_POOL_CAPACITY, until it reaches this value.
+#ifndef ARDUINOJSON_MAX_POOL_CAPACITY
+#  define ARDUINOJSON_MAX_POOL_CAPACITY ARDUINOJSON_POOL_CAPACITY
+#endif
+
 // Initial capacity of the pool list
 #ifndef ARDUINOJSON_INITIAL_POOL_COUNT
 #  define ARDUINOJSON_INITIAL_POOL_COUNT 4
@@ -135,6 +155,58 @@
 #  endif
 #endif
 
+// Index the string pool with a hash table to speed up deduplication
+// Disabled by default on 8-bit platforms because it's not worth the increase in
+// code size
+#ifndef ARDUINOJSON_ENABLE_STRING_POOL_INDEX
+#  if ARDUINOJSON_SIZEOF_POINTER <= 2
+#    define ARDUINOJSON_ENABLE_STRING_POOL_INDEX 0
+#  else
+#    define ARDUINOJSON_ENABLE_STRING_POOL_INDEX 1
+#  endif
+#endif
+
+// Index the members of large objects with a hash table to speed up lookups
+// Disabled by default on 8-bit platforms because it's not worth the increase in
+// code size
+#ifndef ARDUINOJSON_ENABLE_OBJECT_INDEX
+#  if ARDUINOJSON_SIZEOF_POINTER <= 2
+#    define ARDUINOJSON_ENABLE_OBJECT_INDEX 0
+#  else
+#    define ARDUINOJSON_ENABLE_OBJECT_INDEX 1
+#  endif
+#endif
+
+// Index the elements of large arrays to provide random access
+// Disabled by default on 8-bit platforms because it's not worth the increase in
+// code size
+#ifndef ARDUINOJSON_ENABLE_ARRAY_INDEX
+#  if ARDUINOJSON_SIZEOF_POINTER <= 2
+#    define ARDUINOJSON_ENABLE_ARRAY_INDEX 0
+#  else
+#    define ARDUINOJSON_ENABLE_ARRAY_INDEX 1
+#  endif
+#endif
+
+// Maintain the counters of JsonDocument::stats()
+// Disabled by default on 8-bit platforms because it's not worth the increase in
+// code size and in the size of JsonDocument
+#ifndef ARDUINOJSON_ENABLE_STATS
+#  if ARDUINOJSON_SIZEOF_POINTER <= 2
+#    define ARDUINOJSON_ENABLE_STATS 0
+#  else
+#    define ARDUINOJSON_ENABLE_STATS 1
+#  endif
+#endif
+
+// Store the number of elements in each array and object, so that size() runs
+// in constant time
+// Disabled by default because it increases the size of every slot on 32-bit
+// and 64-bit platforms
+#ifndef ARDUINOJSON_CACHE_COLLECTION_SIZE
+#  define ARDUINOJSON_CACHE_COLLECTION_SIZE 0
+#endif
+
 // Number of bytes to store the length of a string
 // https://arduinojson.org/v7/config/string_length_size/
 #ifndef ARDUINOJSON_STRING_LENGTH_SIZE
@@ -279,6 +351,19 @@
 #  define ARDUINOJSON_USE_EXTENSIONS 0
 #endif
 
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX || ARDUINOJSON_ENABLE_ARRAY_INDEX
+#  define ARDUINOJSON_USE_COLLECTION_INDEX 1
+#else
+#  define ARDUINOJSON_USE_COLLECTION_INDEX 0
+#endif
+
+#if defined(__cpp_nontype_template_args) && \
+    __cpp_nontype_template_args >= 201911L
+#  define ARDUINOJSON_HAS_STRING_TEMPLATE_ARGS 1
+#else
+#  define ARDUINOJSON_HAS_STRING_TEMPLATE_ARGS 0
+#endif
+
 #if defined(nullptr)
 #  error nullptr is defined as a macro. Remove the faulty #define or #undef nullptr
 // See https://github.com/bblanchon/ArduinoJson/issues/1355
@@ -0,0 +1,302 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/Filter.hpp>
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+struct CompiledFilterEntry;
+
+// A value of the filter document, with the answers of the Filter's methods
+struct CompiledFilterNode {
+  enum {
+    Allow = 1,
+    AllowArray = 2,
+    AllowObject = 4,
+    AllowValue = 8,
+  };
+
+  uint8_t flags;
+  const CompiledFilterNode* element;   // the filter of the elements
+  const CompiledFilterNode* wildcard;  // the filter of the other members
+  const CompiledFilterEntry* members;  // the filters of the known members
+  size_t capacity;                     // 0 or a power of two
+
+  template <typename TAdaptedString>
+  const CompiledFilterNode* findMember(TAdaptedString key) const;
+};
+
+struct CompiledFilterEntry {
+  const char* key;
+  size_t keyLength;
+  uint32_t hash;
+  const CompiledFilterNode* node;  // null if the entry is empty
+
+  template <typename TAdaptedString>
+  bool matches(TAdaptedString other, uint32_t otherHash) const {
+    return hash == otherHash &&
+           stringEquals(other, adaptString(key, keyLength));
+  }
+};
+
+// The members are in an open-addressing hash table, with linear probing.
+// It's never more than half full.
+template <typename TAdaptedString>
+inline const CompiledFilterNode* CompiledFilterNode::findMember(
+    TAdaptedString key) const {
+  if (!capacity)
+    return wildcard;
+  auto hash = stringHash(key);
+  auto mask = capacity - 1;
+  for (auto i = hash & mask; members[i].node; i = (i + 1) & mask) {
+    if (members[i].matches(key, hash))
+      return members[i].node;
+  }
+  return wildcard;
+}
+
+// The node of an empty filter, or of a filter that failed to compile
+inline const CompiledFilterNode* rejectingFilterNode() {
+  static const CompiledFilterNode node = {0, &node, &node, nullptr, 0};
+  return &node;
+}
+
+// The filter that the deserializers receive, in place of a
+// DeserializationOption::Filter.
+// It's a pointer to a node, so it's as cheap to copy as the AllowAllFilter.
+class CompiledFilterRef {
+ public:
+  explicit CompiledFilterRef(const CompiledFilterNode* node) : node_(node) {}
+
+  bool allow() const {
+    return (node_->flags & CompiledFilterNode::Allow) != 0;
+  }
+
+  bool allowArray() const {
+    return (node_->flags & CompiledFilterNode::AllowArray) != 0;
+  }
+
+  bool allowObject() const {
+    return (node_->flags & CompiledFilterNode::AllowObject) != 0;
+  }
+
+  bool allowValue() const {
+    return (node_->flags & CompiledFilterNode::AllowValue) != 0;
+  }
+
+  template <typename TString>
+  enable_if_t<IsString<TString>::value, CompiledFilterRef> operator[](
+      const TString& key) const {
+    return CompiledFilterRef(node_->findMember(adaptString(key)));
+  }
+
+  CompiledFilterRef operator[](size_t) const {
+    return CompiledFilterRef(node_->element);
+  }
+
+ private:
+  const CompiledFilterNode* node_;
+};
+
+// Converts a filter document into CompiledFilterNodes, in two passes: the
+// first measures the size of the block, the second fills it.
+class CompiledFilterBuilder {
+ public:
+  void measure(JsonVariantConst filter) {
+    nodeCount_++;
+    if (filter == true)
+      return;
+
+    auto array = filter.as<JsonArrayConst>();
+    if (array) {
+      if (!array[0].isNull())
+        measure(array[0]);
+      return;
+    }
+
+    auto object = filter.as<JsonObjectConst>();
+    if (!object)
+      return;
+    if (!object["*"].isNull())
+      measure(object["*"]);
+    entryCount_ += tableCapacity(object.size());
+    for (auto member : object) {
+      charCount_ += member.key().size();
+      if (member.key() != "*" && !member.value().isNull())
+        measure(member.value());
+    }
+  }
+
+  size_t blockSize() const {
+    return nodeCount_ * sizeof(CompiledFilterNode) +
+           entryCount_ * sizeof(CompiledFilterEntry) + charCount_;
+  }
+
+  // Returns the root node
+  const CompiledFilterNode* build(JsonVariantConst filter, void* block) {
+    nextNode_ = reinterpret_cast<CompiledFilterNode*>(block);
+    nextEntry_ = reinterpret_cast<CompiledFilterEntry*>(nextNode_ + nodeCount_);
+    nextChar_ = reinterpret_cast<char*>(nextEntry_ + entryCount_);
+    return compile(filter);
+  }
+
+ private:
+  static size_t tableCapacity(size_t memberCount) {
+    if (!memberCount)
+      return 0;
+    size_t capacity = 4;
+    while (capacity < memberCount * 2)
+      capacity *= 2;
+    return capacity;
+  }
+
+  CompiledFilterNode* compile(JsonVariantConst filter) {
+    DeserializationOption::Filter reference(filter);
+    auto node = nextNode_++;
+    node->flags = uint8_t(
+        (reference.allow() ? CompiledFilterNode::Allow : 0) |
+        (reference.allowArray() ? CompiledFilterNode::AllowArray : 0) |
+        (reference.allowObject() ? CompiledFilterNode::AllowObject : 0) |
+        (reference.allowValue() ? CompiledFilterNode::AllowValue : 0));
+    node->element = rejectingFilterNode();
+    node->wildcard = rejectingFilterNode();
+    node->members = nullptr;
+    node->capacity = 0;
+
+    if (filter == true) {  // "true" means "allow recursively"
+      node->element = node;
+      node->wildcard = node;
+      return node;
+    }
+
+    auto array = filter.as<JsonArrayConst>();
+    if (array) {
+      if (!array[0].isNull())
+        node->element = compile(array[0]);
+      return node;
+    }
+
+    auto object = filter.as<JsonObjectConst>();
+    if (!object)
+      return node;
+    if (!object["*"].isNull())
+      node->wildcard = compile(object["*"]);
+    // the elements of an array get the filter of the other members
+    node->element = node->wildcard;
+
+    auto capacity = tableCapacity(object.size());
+    if (!capacity)
+      return node;
+    auto members = nextEntry_;
+    nextEntry_ += capacity;
+    for (size_t i = 0; i < capacity; i++)
+      members[i].node = nullptr;
+    node->members = members;
+    node->capacity = capacity;
+
+    auto mask = capacity - 1;
+    for (auto member : object) {
+      auto key = member.key();
+      auto hash = stringHash(adaptString(key));
+      auto i = hash & mask;
+      while (members[i].node && !members[i].matches(adaptString(key), hash))
+        i = (i + 1) & mask;
+      if (members[i].node)  // like the Filter, ignore the duplicate keys
+        continue;
+
+      memcpy(nextChar_, key.c_str(), key.size());
+      members[i].key = nextChar_;
+      members[i].keyLength = key.size();
+      members[i].hash = hash;
+      nextChar_ += key.size();
+
+      // like the Filter, use the wildcard if the member is null
+      if (key == "*" || member.value().isNull())
+        members[i].node = node->wildcard;
+      else
+        members[i].node = compile(member.value());
+    }
+    return node;
+  }
+
+  size_t nodeCount_ = 0;
+  size_t entryCount_ = 0;
+  size_t charCount_ = 0;
+  CompiledFilterNode* nextNode_ = nullptr;
+  CompiledFilterEntry* nextEntry_ = nullptr;
+  char* nextChar_ = nullptr;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// A filter document converted into a trie, stored in a single block of
+// memory.
+// With a DeserializationOption::Filter, the deserializer looks up each key of
+// the input in the filter document; with a CompiledFilter, it looks it up in a
+// hash table.
+// Pass filter() to deserializeJson() or deserializeMsgPack(), in place of the
+// DeserializationOption::Filter.
+class CompiledFilter {
+ public:
+  // Converts the filter into a block allocated with the specified allocator
+  explicit CompiledFilter(
+      JsonVariantConst filter,
+      Allocator* alloc = detail::DefaultAllocator::instance())
+      : allocator_(alloc) {
+    detail::CompiledFilterBuilder builder;
+    builder.measure(filter);
+    block_ = alloc->allocate(builder.blockSize());
+    if (block_)
+      root_ = builder.build(filter, block_);
+  }
+
+  CompiledFilter(CompiledFilter&& src) : allocator_(src.allocator_) {
+    swap(*this, src);
+  }
+
+  CompiledFilter(const CompiledFilter&) = delete;
+
+  CompiledFilter& operator=(CompiledFilter src) {
+    swap(*this, src);
+    return *this;
+  }
+
+  ~CompiledFilter() {
+    if (block_)
+      allocator_->deallocate(block_);
+  }
+
+  friend void swap(CompiledFilter& a, CompiledFilter& b) {
+    detail::swap_(a.block_, b.block_);
+    detail::swap_(a.root_, b.root_);
+    detail::swap_(a.allocator_, b.allocator_);
+  }
+
+  // Returns true if the conversion failed because allocation failed.
+  // In that case, the filter rejects everything.
+  bool overflowed() const {
+    return !block_;
+  }
+
+  // Returns the option to pass to the deserializer.
+  // It points to the block, so it must not outlive the CompiledFilter.
+  detail::CompiledFilterRef filter() const {
+    return detail::CompiledFilterRef(root_);
+  }
+
+ private:
+  void* block_ = nullptr;
+  const detail::CompiledFilterNode* root_ = detail::rejectingFilterNode();
+  Allocator* allocator_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
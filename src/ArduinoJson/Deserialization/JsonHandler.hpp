@@ -0,0 +1,48 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Numbers/JsonFloat.hpp>
+#include <ArduinoJson/Numbers/JsonInteger.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Strings/JsonString.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Receives the values of a JSON or MessagePack input as deserializeJson() or
+// deserializeMsgPack() reads them, instead of a JsonDocument.
+// Derive from this class and override the functions you need.
+// The strings are only valid during the call; with
+// DeserializationOption::CopyFromInput, they may not be null-terminated.
+class JsonHandler {
+ public:
+  virtual ~JsonHandler() = default;
+
+  virtual void onStartObject() {}
+  virtual void onKey(JsonString) {}
+  virtual void onEndObject() {}
+
+  virtual void onStartArray() {}
+  virtual void onEndArray() {}
+
+  virtual void onNull() {}
+  virtual void onBoolean(bool) {}
+  virtual void onInteger(JsonInteger) {}
+  virtual void onUnsignedInteger(JsonUInt) {}
+  virtual void onFloat(JsonFloat) {}
+  virtual void onString(JsonString) {}
+
+  // Receives the MessagePack binaries and extensions, header included
+  virtual void onRawValue(JsonString) {}
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+template <typename T>
+using is_json_handler = is_base_of<JsonHandler, T>;
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -39,6 +39,8 @@ struct BoundedReader {
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
 
+#include <ArduinoJson/Deserialization/Readers/CopyFromInputReader.hpp>
+#include <ArduinoJson/Deserialization/Readers/InSituReader.hpp>
 #include <ArduinoJson/Deserialization/Readers/IteratorReader.hpp>
 #include <ArduinoJson/Deserialization/Readers/RamReader.hpp>
 #include <ArduinoJson/Deserialization/Readers/VariantReader.hpp>
@@ -71,4 +73,15 @@ BoundedReader<TChar*> makeReader(TChar* input, size_t inputSize) {
   return BoundedReader<TChar*>{input, inputSize};
 }
 
+// A reader that exposes its buffer with cursor(), end(), and setCursor().
+// end() returns null if the input is null-terminated.
+template <typename TReader, typename = void>
+struct is_contiguous_reader : false_type {};
+
+template <typename TReader>
+struct is_contiguous_reader<
+    TReader,
+    enable_if_t<is_convertible<decltype(declval<const TReader>().cursor()),
+                               const char*>::value>> : true_type {};
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
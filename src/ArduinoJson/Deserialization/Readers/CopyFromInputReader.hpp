@@ -0,0 +1,28 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Wraps a reader to enable DeserializationOption::CopyFromInput
+template <typename TReader>
+struct CopyFromInputReader : TReader {
+  explicit CopyFromInputReader(const TReader& reader) : TReader(reader) {}
+};
+
+template <typename TReader>
+struct is_copy_from_input_reader : false_type {};
+
+template <typename TReader>
+struct is_copy_from_input_reader<CopyFromInputReader<TReader>> : true_type {};
+
+template <typename TReader>
+CopyFromInputReader<TReader> copyFromInput(const TReader& reader) {
+  return CopyFromInputReader<TReader>(reader);
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
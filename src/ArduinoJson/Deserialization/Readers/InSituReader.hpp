@@ -0,0 +1,49 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Reads a mutable buffer, in which the deserializer stores the strings
+// (see DeserializationOption::InSitu)
+class InSituReader {
+ public:
+  // end is null if the input is null-terminated
+  explicit InSituReader(char* ptr, char* end = nullptr)
+      : ptr_(ptr), end_(ptr ? end : nullptr) {}
+
+  int read() {
+    if (ptr_ == end_)
+      return -1;
+    return static_cast<unsigned char>(*ptr_++);
+  }
+
+  size_t readBytes(char* buffer, size_t length) {
+    size_t i = 0;
+    while (i < length && ptr_ != end_)
+      buffer[i++] = *ptr_++;
+    return i;
+  }
+
+  char* cursor() const {
+    return ptr_;
+  }
+
+  const char* end() const {
+    return end_;
+  }
+
+  void setCursor(char* ptr) {
+    ptr_ = ptr;
+  }
+
+ private:
+  char* ptr_;
+  char* end_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
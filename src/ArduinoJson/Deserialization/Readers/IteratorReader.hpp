@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Strings/StringTraits.hpp>
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
@@ -29,10 +30,43 @@ class IteratorReader {
       buffer[i++] = *ptr_++;
     return i;
   }
+
+  // The following functions let the deserializers scan the input in place
+  // (only used when TIterator is const char*, see is_contiguous_reader)
+
+  TIterator cursor() const {
+    return ptr_;
+  }
+
+  TIterator end() const {
+    return end_;
+  }
+
+  void setCursor(TIterator ptr) {
+    ptr_ = ptr;
+  }
+};
+
+// Containers that expose a contiguous buffer, like std::string
+template <typename TSource>
+struct is_contiguous_container
+    : bool_constant<string_traits<TSource>::has_data &&
+                    string_traits<TSource>::has_size> {};
+
+template <typename TSource>
+struct Reader<TSource,
+              enable_if_t<is_contiguous_container<TSource>::value,
+                          void_t<typename TSource::const_iterator>>>
+    : IteratorReader<const char*> {
+  explicit Reader(const TSource& source)
+      : IteratorReader<const char*>(source.data(),
+                                    source.data() + source.size()) {}
 };
 
 template <typename TSource>
-struct Reader<TSource, void_t<typename TSource::const_iterator>>
+struct Reader<TSource,
+              enable_if_t<!is_contiguous_container<TSource>::value,
+                          void_t<typename TSource::const_iterator>>>
     : IteratorReader<typename TSource::const_iterator> {
   explicit Reader(const TSource& source)
       : IteratorReader<typename TSource::const_iterator>(source.begin(),
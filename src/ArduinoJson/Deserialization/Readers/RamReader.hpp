@@ -35,6 +35,19 @@ struct Reader<TSource*, enable_if_t<IsCharOrVoid<TSource>::value>> {
       buffer[i] = *ptr_++;
     return length;
   }
+
+  const char* cursor() const {
+    return ptr_;
+  }
+
+  // The input is null-terminated
+  const char* end() const {
+    return nullptr;
+  }
+
+  void setCursor(const char* ptr) {
+    ptr_ = ptr;
+  }
 };
 
 template <typename TSource>
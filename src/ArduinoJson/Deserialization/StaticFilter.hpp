@@ -0,0 +1,306 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Polyfills/integer.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+
+#include <string.h>  // memcmp
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A string as a type, for the keys of a StaticFilter
+template <char... Chars>
+struct CharSequence {
+  static constexpr size_t size() {
+    return sizeof...(Chars);
+  }
+
+  static constexpr const char* data() {
+    return chars;
+  }
+
+  static constexpr char chars[] = {Chars..., '\0'};
+};
+
+template <char... Chars>
+constexpr char CharSequence<Chars...>::chars[];
+
+// Appends the first N characters to TSequence
+template <size_t N, typename TSequence, char... Chars>
+struct TakeChars {
+  static_assert(N == 0, "ARDUINOJSON_STRING() supports up to 32 characters");
+  using type = TSequence;
+};
+
+template <size_t N, char... Taken, char C, char... Chars>
+struct TakeChars<N, CharSequence<Taken...>, C, Chars...>
+    : conditional_t<N == 0, type_identity<CharSequence<Taken...>>,
+                    TakeChars<N - 1, CharSequence<Taken..., C>, Chars...>> {
+};
+
+#if ARDUINOJSON_HAS_STRING_TEMPLATE_ARGS
+// A string literal as a template argument (C++20)
+template <size_t N>
+struct FixedString {
+  constexpr FixedString(const char (&s)[N]) {
+    for (size_t i = 0; i < N; i++)
+      chars[i] = s[i];
+  }
+
+  char chars[N] = {};
+};
+
+template <FixedString S>
+struct FixedStringName {
+  static constexpr size_t size() {
+    return sizeof(S.chars) - 1;
+  }
+
+  static constexpr const char* data() {
+    return S.chars;
+  }
+};
+#endif
+
+template <size_t N>
+constexpr char charAt(const char (&s)[N], size_t i) {
+  return i < N ? s[i] : '\0';
+}
+
+// The filter of a value, as the deserializer sees it
+struct StaticFilterNode {
+  enum {
+    Allow = 1,
+    AllowArray = 2,
+    AllowObject = 4,
+    AllowValue = 8,
+  };
+
+  uint8_t flags;
+  const StaticFilterNode* element;
+  const StaticFilterNode* (*findMember)(const char* key, size_t length);
+};
+
+// The node of each spec is a constant, that refers to the other constants
+template <typename TSpec>
+struct StaticFilterNodeOf {
+  static const StaticFilterNode value;
+};
+
+template <typename TSpec>
+const StaticFilterNode StaticFilterNodeOf<TSpec>::value = {
+    TSpec::flags,
+    &StaticFilterNodeOf<typename TSpec::Element>::value,
+    &TSpec::findMember,
+};
+
+// Like false in a filter document
+struct RejectSpec {
+  static constexpr uint8_t flags = 0;
+
+  using Element = RejectSpec;
+
+  static const StaticFilterNode* findMember(const char*, size_t) {
+    return &StaticFilterNodeOf<RejectSpec>::value;
+  }
+};
+
+// Like true in a filter document
+struct AllowAllSpec {
+  static constexpr uint8_t flags =
+      StaticFilterNode::Allow | StaticFilterNode::AllowArray |
+      StaticFilterNode::AllowObject | StaticFilterNode::AllowValue;
+
+  using Element = AllowAllSpec;
+
+  static const StaticFilterNode* findMember(const char*, size_t) {
+    return &StaticFilterNodeOf<AllowAllSpec>::value;
+  }
+};
+
+// Like [element] in a filter document
+template <typename TElementSpec>
+struct ArraySpec {
+  static constexpr uint8_t flags =
+      StaticFilterNode::Allow | StaticFilterNode::AllowArray;
+
+  using Element = TElementSpec;
+
+  static const StaticFilterNode* findMember(const char*, size_t) {
+    return &StaticFilterNodeOf<RejectSpec>::value;
+  }
+};
+
+template <typename TName>
+constexpr bool isWildcard() {
+  return TName::size() == 1 && TName::data()[0] == '*';
+}
+
+// The spec of the first "*" member, or RejectSpec
+template <typename... TMembers>
+struct WildcardSpec {
+  using type = RejectSpec;
+};
+
+template <typename TMember, typename... TMembers>
+struct WildcardSpec<TMember, TMembers...>
+    : conditional_t<isWildcard<typename TMember::Name>(),
+                    type_identity<typename TMember::Spec>,
+                    WildcardSpec<TMembers...>> {};
+
+// Like {members} in a filter document
+template <typename... TMembers>
+struct ObjectSpec {
+  static constexpr uint8_t flags =
+      StaticFilterNode::Allow | StaticFilterNode::AllowObject;
+
+  // the elements of an array get the filter of the other members
+  using Element = typename WildcardSpec<TMembers...>::type;
+
+  static const StaticFilterNode* findMember(const char* key, size_t length) {
+    return match<TMembers...>(key, length);
+  }
+
+ private:
+  // Compares the key with each member in turn.
+  // The lengths of the names are constants, so the compiler can turn the
+  // length tests into a switch, and memcmp() only runs when the length matches.
+  template <typename... TOthers>
+  static enable_if_t<sizeof...(TOthers) == 0, const StaticFilterNode*> match(
+      const char*, size_t) {
+    return &StaticFilterNodeOf<Element>::value;
+  }
+
+  template <typename TMember, typename... TOthers>
+  static const StaticFilterNode* match(const char* key, size_t length) {
+    using Name = typename TMember::Name;
+    if (length == Name::size() && memcmp(key, Name::data(), length) == 0)
+      return &StaticFilterNodeOf<typename TMember::Spec>::value;
+    return match<TOthers...>(key, length);
+  }
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// An array, whose elements are filtered by the children
+template <typename... TChildren>
+struct Each {};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The spec of the children of a Member, an Each, or a StaticFilter:
+// nothing allows everything, an Each allows an array, and Members allow an
+// object
+template <typename... TChildren>
+struct SpecOf {
+  using type = ObjectSpec<TChildren...>;
+};
+
+template <>
+struct SpecOf<> {
+  using type = AllowAllSpec;
+};
+
+template <typename... TChildren>
+struct SpecOf<DeserializationOption::Each<TChildren...>> {
+  using type = ArraySpec<typename SpecOf<TChildren...>::type>;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+
+// A member of an object, filtered by the children.
+// TName is the type returned by ARDUINOJSON_STRING().
+template <typename TName, typename... TChildren>
+struct Member {
+  using Name = TName;
+  using Spec = typename detail::SpecOf<TChildren...>::type;
+};
+
+#if ARDUINOJSON_HAS_STRING_TEMPLATE_ARGS
+// The same as Member, with the name in a string literal
+template <detail::FixedString Name, typename... TChildren>
+using Key = Member<detail::FixedStringName<Name>, TChildren...>;
+#endif
+
+// A filter whose structure is known at compile time. For example,
+//   StaticFilter<Member<ARDUINOJSON_STRING("temp")>,
+//                Member<ARDUINOJSON_STRING("sensors"),
+//                       Each<Member<ARDUINOJSON_STRING("id")>>>>
+// or, in C++20,
+//   StaticFilter<Key<"temp">, Key<"sensors", Each<Key<"id">>>>
+// allows the same values as the filter {"temp":true,"sensors":[{"id":true}]}.
+// It needs no memory: the filter is made of constants, and the keys are
+// compared with the names of the members directly.
+template <typename... TChildren>
+class StaticFilter {
+ public:
+  StaticFilter()
+      : node_(&detail::StaticFilterNodeOf<
+              typename detail::SpecOf<TChildren...>::type>::value) {}
+
+  bool allow() const {
+    return (node_->flags & detail::StaticFilterNode::Allow) != 0;
+  }
+
+  bool allowArray() const {
+    return (node_->flags & detail::StaticFilterNode::AllowArray) != 0;
+  }
+
+  bool allowObject() const {
+    return (node_->flags & detail::StaticFilterNode::AllowObject) != 0;
+  }
+
+  bool allowValue() const {
+    return (node_->flags & detail::StaticFilterNode::AllowValue) != 0;
+  }
+
+  template <typename TString>
+  detail::enable_if_t<detail::IsString<TString>::value, StaticFilter>
+  operator[](const TString& key) const {
+    auto s = detail::adaptString(key);
+    return StaticFilter(node_->findMember(s.data(), s.size()));
+  }
+
+  StaticFilter operator[](size_t) const {
+    return StaticFilter(node_->element);
+  }
+
+ private:
+  explicit StaticFilter(const detail::StaticFilterNode* node) : node_(node) {}
+
+  const detail::StaticFilterNode* node_;
+};
+
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+// The type of a string literal of up to 32 characters, for the names of the
+// members of a StaticFilter
+#define ARDUINOJSON_STRING(s)                                                \
+  ArduinoJson::detail::TakeChars<                                            \
+      sizeof(s) - 1, ArduinoJson::detail::CharSequence<>,                    \
+      ARDUINOJSON_STRING_CHARS_(s, 0), ARDUINOJSON_STRING_CHARS_(s, 8),      \
+      ARDUINOJSON_STRING_CHARS_(s, 16), ARDUINOJSON_STRING_CHARS_(s, 24)>::type
+#define ARDUINOJSON_STRING_CHARS_(s, i)                                      \
+  ArduinoJson::detail::charAt(s, i), ArduinoJson::detail::charAt(s, i + 1),  \
+      ArduinoJson::detail::charAt(s, i + 2),                                 \
+      ArduinoJson::detail::charAt(s, i + 3),                                 \
+      ArduinoJson::detail::charAt(s, i + 4),                                 \
+      ArduinoJson::detail::charAt(s, i + 5),                                 \
+      ArduinoJson::detail::charAt(s, i + 6),                                 \
+      ArduinoJson::detail::charAt(s, i + 7)
@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <ArduinoJson/Deserialization/CopyFromInput.hpp>
 #include <ArduinoJson/Deserialization/DeserializationError.hpp>
 #include <ArduinoJson/Deserialization/DeserializationOptions.hpp>
+#include <ArduinoJson/Deserialization/InSitu.hpp>
+#include <ArduinoJson/Deserialization/JsonHandler.hpp>
 #include <ArduinoJson/Deserialization/Reader.hpp>
 #include <ArduinoJson/Polyfills/utility.hpp>
 
@@ -27,7 +30,25 @@ struct first_or_void<T, Rest...> {
 template <class T>
 using is_deserialize_destination =
     bool_constant<is_base_of<JsonDocument, remove_cv_t<T>>::value ||
-                  IsVariant<T>::value>;
+                  IsVariant<T>::value || is_json_handler<T>::value>;
+
+// A meta-function that returns true if the deserializer supports
+// DeserializationOption::InSitu and DeserializationOption::CopyFromInput
+template <template <typename> class TDeserializer>
+struct supports_input_modes : false_type {};
+
+template <typename TDestination>
+inline void clearDestination(TDestination& dst) {
+  dst.clear();
+}
+
+// Reuses the memory pools of a document that reserved memory
+inline void clearDestination(JsonDocument& doc) {
+  if (VariantAttorney::getResourceManager(doc)->reserved())
+    doc.reset();
+  else
+    doc.clear();
+}
 
 template <typename TDestination>
 inline void shrinkJsonDocument(TDestination&) {
@@ -35,26 +56,41 @@ inline void shrinkJsonDocument(TDestination&) {
 }
 
 #if ARDUINOJSON_AUTO_SHRINK
+// Keeps the memory of a document that reserved memory
 inline void shrinkJsonDocument(JsonDocument& doc) {
-  doc.shrinkToFit();
+  if (!VariantAttorney::getResourceManager(doc)->reserved())
+    doc.shrinkToFit();
 }
 #endif
 
 template <template <typename> class TDeserializer, typename TDestination,
           typename TReader, typename TOptions>
-DeserializationError doDeserialize(TDestination&& dst, TReader reader,
-                                   TOptions options) {
+enable_if_t<!is_json_handler<TDestination>::value, DeserializationError>
+doDeserialize(TDestination&& dst, TReader reader, TOptions options) {
   auto data = VariantAttorney::getOrCreateData(dst);
   if (!data)
     return DeserializationError::NoMemory;
   auto resources = VariantAttorney::getResourceManager(dst);
-  dst.clear();
+  clearDestination(dst);
   auto err = TDeserializer<TReader>(resources, reader)
                  .parse(*data, options.filter, options.nestingLimit);
   shrinkJsonDocument(dst);
   return err;
 }
 
+// Sends the values to the handler instead of storing them.
+// The ResourceManager only holds the buffer of the current string.
+template <template <typename> class TDeserializer, typename THandler,
+          typename TReader, typename TOptions>
+enable_if_t<is_json_handler<THandler>::value, DeserializationError>
+doDeserialize(THandler& handler, TReader reader, TOptions options) {
+  static_assert(is_same<decltype(options.filter), AllowAllFilter>::value,
+                "Filters are not supported with a JsonHandler");
+  ResourceManager resources;
+  return TDeserializer<TReader>(&resources, reader)
+      .parse(handler, options.nestingLimit);
+}
+
 template <template <typename> class TDeserializer, typename TDestination,
           typename TStream, typename... Args,
           typename = enable_if_t<  // issue #1897
@@ -75,4 +111,55 @@ DeserializationError deserialize(TDestination&& dst, TChar* input,
                                       makeDeserializationOptions(args...));
 }
 
+template <template <typename> class TDeserializer, typename TDestination,
+          typename TStream, typename... Args>
+DeserializationError deserialize(TDestination&& dst, TStream&& input,
+                                 DeserializationOption::CopyFromInputMode,
+                                 Args... args) {
+  static_assert(supports_input_modes<TDeserializer>::value,
+                "CopyFromInput is only supported by deserializeJson()");
+  return doDeserialize<TDeserializer>(
+      dst, copyFromInput(makeReader(detail::forward<TStream>(input))),
+      makeDeserializationOptions(args...));
+}
+
+template <template <typename> class TDeserializer, typename TDestination,
+          typename TChar, typename Size, typename... Args,
+          typename = enable_if_t<is_integral<Size>::value>>
+DeserializationError deserialize(TDestination&& dst, TChar* input,
+                                 Size inputSize,
+                                 DeserializationOption::CopyFromInputMode,
+                                 Args... args) {
+  static_assert(supports_input_modes<TDeserializer>::value,
+                "CopyFromInput is only supported by deserializeJson()");
+  return doDeserialize<TDeserializer>(
+      dst, copyFromInput(makeReader(input, size_t(inputSize))),
+      makeDeserializationOptions(args...));
+}
+
+template <template <typename> class TDeserializer, typename TDestination,
+          typename... Args>
+DeserializationError deserialize(TDestination&& dst, char* input,
+                                 DeserializationOption::InSituMode,
+                                 Args... args) {
+  static_assert(supports_input_modes<TDeserializer>::value,
+                "InSitu is only supported by deserializeJson()");
+  return doDeserialize<TDeserializer>(dst, InSituReader(input),
+                                      makeDeserializationOptions(args...));
+}
+
+template <template <typename> class TDeserializer, typename TDestination,
+          typename Size, typename... Args,
+          typename = enable_if_t<is_integral<Size>::value>>
+DeserializationError deserialize(TDestination&& dst, char* input,
+                                 Size inputSize,
+                                 DeserializationOption::InSituMode,
+                                 Args... args) {
+  static_assert(supports_input_modes<TDeserializer>::value,
+                "InSitu is only supported by deserializeJson()");
+  return doDeserialize<TDeserializer>(
+      dst, InSituReader(input, input + size_t(inputSize)),
+      makeDeserializationOptions(args...));
+}
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
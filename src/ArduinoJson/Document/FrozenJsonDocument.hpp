@@ -0,0 +1,276 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Memory/MonotonicAllocator.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Measures a copy of a variant without making it: the number of slots, and
+// the size of the buffer that a MonotonicAllocator needs to hold the copy
+// once JsonDocument::reserve() allocated the slots and the strings.
+// It's an upper bound because it ignores the strings that the copy
+// deduplicates, and because it counts every step of the growth of the
+// indexes (the previous table stays in the buffer).
+class CopySizer {
+ public:
+  CopySizer(const ResourceManager* resources) : resources_(resources) {}
+
+  void add(const VariantData* variant) {
+    if (!variant)
+      return;
+#if ARDUINOJSON_USE_EXTENSIONS
+    if (variant->type() & VariantTypeBits::ExtensionBit)
+      slots_++;
+#endif
+    if (variant->type() & VariantTypeBits::OwnedStringBit) {
+      auto str = variant->type() == VariantType::RawString
+                     ? variant->asRawString()
+                     : variant->asString();
+      stringBytes_ += addPadding(sizeofString(str.size()));
+      strings_++;
+    }
+    auto collection = variant->asCollection();
+    if (!collection)
+      return;
+    size_t n = 0;
+    for (auto it = collection->createIterator(resources_); !it.done();
+         it.next(resources_)) {
+      add(it.data());
+      n++;
+    }
+    slots_ += n;
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+    // see ArrayData::addToIndex()
+    if (variant->isArray() && n > ArrayData::indexThreshold) {
+      indexBytes_ += sizeofTable(ArrayData::indexThreshold + 1, n,
+                                 sizeof(SlotId));
+      indexCount_++;
+    }
+#endif
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+    // see ObjectData::addToIndex()
+    if (variant->isObject() && n / 2 > ObjectData::indexThreshold) {
+      indexBytes_ += sizeofTable(ObjectData::indexThreshold * 4, n + 2,
+                                 sizeof(SlotId));
+      indexCount_++;
+    }
+#endif
+  }
+
+  size_t slots() const {
+    return slots_;
+  }
+
+  size_t stringBytes() const {
+    return stringBytes_;
+  }
+
+  size_t bufferSize() const {
+    // see MemoryPoolList::reserve()
+    size_t pools = (slots_ + ARDUINOJSON_POOL_CAPACITY - 1) /
+                   ARDUINOJSON_POOL_CAPACITY;
+    size_t size = pools * MonotonicAllocator::sizeofBlock(
+                              ResourceManager::slotSize *
+                              ARDUINOJSON_POOL_CAPACITY);
+    if (pools > ARDUINOJSON_INITIAL_POOL_COUNT)
+      size += MonotonicAllocator::sizeofBlock(pools *
+                                              sizeof(MemoryPool<VariantData>));
+    if (stringBytes_)
+      size += MonotonicAllocator::sizeofBlock(
+          StringArena::sizeofChunk(stringBytes_));
+#if ARDUINOJSON_ENABLE_STRING_POOL_INDEX
+    // see StringPool::growIndex()
+    if (strings_ > StringPool::indexThreshold)
+      size += sizeofTable(StringPool::indexThreshold * 4, strings_ * 2 + 2,
+                          sizeof(StringNode*));
+#endif
+#if ARDUINOJSON_USE_COLLECTION_INDEX
+    // see CollectionIndexMap::grow()
+    if (indexCount_)
+      size += indexBytes_ +
+              sizeofTable(CollectionIndexMap::initialCapacity,
+                          indexCount_ * 2 + 2,
+                          CollectionIndexMap::sizeofEntries(1));
+#endif
+    return size;
+  }
+
+ private:
+  // Returns the bytes that a table consumes in a MonotonicAllocator as it
+  // doubles from `capacity` until it has at least `minCapacity` entries
+  static size_t sizeofTable(size_t capacity, size_t minCapacity,
+                            size_t entrySize) {
+    size_t size = MonotonicAllocator::sizeofBlock(capacity * entrySize);
+    while (capacity < minCapacity) {
+      capacity *= 2;
+      size += MonotonicAllocator::sizeofBlock(capacity * entrySize);
+    }
+    return size;
+  }
+
+  const ResourceManager* resources_;
+  size_t slots_ = 0;
+  size_t stringBytes_ = 0;
+  size_t strings_ = 0;
+  size_t indexBytes_ = 0;
+  size_t indexCount_ = 0;
+};
+
+// Builds the indexes of the large collections ahead of time, because reading
+// a document never creates them
+inline void buildCollectionIndexes(VariantData* variant,
+                                   ResourceManager* resources) {
+  auto collection = variant->asCollection();
+  if (!collection)
+    return;
+  auto array = variant->asArray();
+  if (array)
+    array->buildIndex(resources);
+  auto object = variant->asObject();
+  if (object)
+    object->buildIndex(resources);
+  for (auto it = collection->createIterator(resources); !it.done();
+       it.next(resources))
+    buildCollectionIndexes(it.data(), resources);
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// An immutable copy of a document, stored in a single block of memory.
+// Several threads can read it concurrently, without locking, because reading
+// a frozen document never modifies it.
+// To reload it, keep it in a std::shared_ptr<const FrozenJsonDocument> and
+// replace the pointer with std::atomic_store().
+class FrozenJsonDocument {
+ public:
+  // Copies the source into a block allocated with the specified allocator
+  explicit FrozenJsonDocument(
+      JsonVariantConst src,
+      Allocator* alloc = detail::DefaultAllocator::instance())
+      : allocator_(alloc) {
+    detail::CopySizer sizer(detail::VariantAttorney::getResourceManager(src));
+    sizer.add(detail::VariantAttorney::getData(src));
+
+    auto p = alloc->allocate(sizeof(Block) + sizer.bufferSize());
+    if (!p)
+      return;
+    block_ = new (p) Block(sizer.bufferSize(), alloc);
+    auto& doc = block_->doc;
+    if (!doc.reserve(sizer.slots(), sizer.stringBytes())) {
+      block_->~Block();
+      alloc->deallocate(block_);
+      block_ = nullptr;
+      return;
+    }
+    doc.as<JsonVariant>().set(src);
+    detail::buildCollectionIndexes(
+        detail::VariantAttorney::getData(doc),
+        detail::VariantAttorney::getResourceManager(doc));
+  }
+
+  FrozenJsonDocument(FrozenJsonDocument&& src) : allocator_(src.allocator_) {
+    swap(*this, src);
+  }
+
+  FrozenJsonDocument(const FrozenJsonDocument&) = delete;
+
+  FrozenJsonDocument& operator=(FrozenJsonDocument src) {
+    swap(*this, src);
+    return *this;
+  }
+
+  ~FrozenJsonDocument() {
+    if (block_) {
+      block_->~Block();
+      allocator_->deallocate(block_);
+    }
+  }
+
+  friend void swap(FrozenJsonDocument& a, FrozenJsonDocument& b) {
+    detail::swap_(a.block_, b.block_);
+    detail::swap_(a.allocator_, b.allocator_);
+  }
+
+  // Returns true if the copy failed because allocation failed
+  bool overflowed() const {
+    return !block_ || block_->doc.overflowed();
+  }
+
+  operator JsonVariantConst() const {
+    return root();
+  }
+
+  template <typename T>
+  T as() const {
+    return root().as<T>();
+  }
+
+  template <typename T>
+  bool is() const {
+    return root().is<T>();
+  }
+
+  bool isNull() const {
+    return root().isNull();
+  }
+
+  size_t size() const {
+    return root().size();
+  }
+
+  size_t nesting() const {
+    return root().nesting();
+  }
+
+  template <typename TString>
+  detail::enable_if_t<detail::IsString<TString>::value, JsonVariantConst>
+  operator[](const TString& key) const {
+    return root()[key];
+  }
+
+  template <typename TChar>
+  detail::enable_if_t<detail::IsString<TChar*>::value, JsonVariantConst>
+  operator[](TChar* key) const {
+    return root()[key];
+  }
+
+  JsonVariantConst operator[](size_t index) const {
+    return root()[index];
+  }
+
+ private:
+  // The header of the block; the memory of the document follows.
+  // The document is destroyed before the allocator that holds its memory.
+  struct Block {
+    Block(size_t capacity, Allocator* upstream)
+        : allocator(this + 1, capacity, upstream), doc(&allocator) {}
+
+    static void* operator new(size_t, void* p) noexcept {
+      return p;
+    }
+
+    static void operator delete(void*, void*) noexcept {}
+
+    MonotonicAllocator allocator;
+    JsonDocument doc;
+  };
+
+  JsonVariantConst root() const {
+    return block_ ? block_->doc.as<JsonVariantConst>() : JsonVariantConst();
+  }
+
+  Block* block_ = nullptr;
+  Allocator* allocator_;
+};
+
+inline FrozenJsonDocument JsonDocument::freeze() const {
+  return FrozenJsonDocument(*this, allocator());
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -15,6 +15,8 @@
 
 ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
 
+class FrozenJsonDocument;
+
 // A JSON document.
 // https://arduinojson.org/v7/api/jsondocument/
 class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
@@ -63,12 +65,62 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
     return resources_.allocator();
   }
 
+  // Allocates enough memory for the specified number of variants, plus a
+  // buffer of stringBytes for the strings, so that filling the document
+  // doesn't need to call the allocator.
+  // deserializeJson() and deserializeMsgPack() reuse this memory instead of
+  // releasing it. shrinkToFit() releases the unused memory; clear(),
+  // set(), and to<T>() release everything, reset() keeps the memory for the
+  // next content.
+  // Returns false if allocation fails.
+  bool reserve(size_t slots, size_t stringBytes = 0) {
+    return resources_.reserve(slots, stringBytes);
+  }
+
+  // Lets the memory pools double in size, from ARDUINOJSON_POOL_CAPACITY up
+  // to the specified number of slots, so that large documents need fewer
+  // pools. Must be called before the first pool is allocated.
+  // Returns false if the document already has memory pools.
+  bool setMaxPoolCapacity(size_t slots) {
+    return resources_.setMaxPoolCapacity(slots);
+  }
+
+  // Returns an immutable copy of the document that several threads can read
+  // concurrently.
+  FrozenJsonDocument freeze() const;
+
+  // Allocates the strings in large chunks instead of one by one.
+  // This reduces the number of calls to the allocator, but the memory of a
+  // removed string is only recycled when the document is cleared.
+  void useStringArena(bool enabled = true) {
+    resources_.useStringArena(enabled);
+  }
+
   // Reduces the capacity of the memory pool to match the current usage.
   // https://arduinojson.org/v7/api/jsondocument/shrinktofit/
   void shrinkToFit() {
     resources_.shrinkToFit();
   }
 
+  // Copies the document in densely packed slots, in depth-first order, and
+  // releases the memory of the removed values and strings.
+  // It temporarily needs the memory for both copies; if allocation fails, it
+  // returns false and leaves the document unchanged.
+  // All the references to the content become invalid.
+  bool compact() {
+    JsonDocument tmp(allocator());
+    tmp.resources_.copySettings(resources_);
+    if (!tmp.set(*this) || tmp.overflowed())
+      return false;
+    swap(*this, tmp);
+#if ARDUINOJSON_ENABLE_STATS
+    tmp.clear();  // counts the release of the old content
+    resources_.addStats(tmp.resources_);
+#endif
+    shrinkToFit();
+    return true;
+  }
+
   // Casts the root to the specified type.
   // https://arduinojson.org/v7/api/jsondocument/as/
   template <typename T>
@@ -90,6 +142,13 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
     data_.reset();
   }
 
+  // Empties the document but keeps the memory pools for the next use.
+  // Call shrinkToFit() to release them.
+  void reset() {
+    resources_.reset();
+    data_.reset();
+  }
+
   // Returns true if the root is of the specified type.
   // https://arduinojson.org/v7/api/jsondocument/is/
   template <typename T>
@@ -116,6 +175,14 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
     return resources_.overflowed();
   }
 
+#if ARDUINOJSON_ENABLE_STATS
+  // Returns the memory statistics of the document.
+  // All the counters are maintained incrementally, so this function is cheap.
+  MemoryStats stats() const {
+    return resources_.stats();
+  }
+#endif
+
   // Returns the depth (nesting level) of the array.
   // https://arduinojson.org/v7/api/jsondocument/nesting/
   size_t nesting() const {
@@ -7,6 +7,7 @@
 #include <ArduinoJson/Deserialization/deserialize.hpp>
 #include <ArduinoJson/Json/EscapeSequence.hpp>
 #include <ArduinoJson/Json/Latch.hpp>
+#include <ArduinoJson/Json/Scanner.hpp>
 #include <ArduinoJson/Json/Utf16.hpp>
 #include <ArduinoJson/Json/Utf8.hpp>
 #include <ArduinoJson/Memory/ResourceManager.hpp>
@@ -18,6 +19,80 @@
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
+inline bool isBetween(char c, char min, char max) {
+  return min <= c && c <= max;
+}
+
+inline bool canBeInNumber(char c) {
+  return isBetween(c, '0', '9') || c == '+' || c == '-' || c == '.' ||
+#if ARDUINOJSON_ENABLE_NAN || ARDUINOJSON_ENABLE_INFINITY
+         isBetween(c, 'A', 'Z') || isBetween(c, 'a', 'z');
+#else
+         c == 'e' || c == 'E';
+#endif
+}
+
+inline bool canBeInNonQuotedString(char c) {
+  return isBetween(c, '0', '9') || isBetween(c, '_', 'z') ||
+         isBetween(c, 'A', 'Z');
+}
+
+inline bool isQuote(char c) {
+  return c == '\'' || c == '\"';
+}
+
+inline uint8_t decodeHex(char c) {
+  if (c < 'A')
+    return uint8_t(c - '0');
+  c = char(c & ~0x20);  // uppercase
+  return uint8_t(c - 'A' + 10);
+}
+
+// Parses the number in s, and stores it in the variant
+inline DeserializationError::Code setNumericValue(VariantData& result,
+                                                  const char* s,
+                                                  ResourceManager* resources) {
+  auto number = parseNumber(s);
+  switch (number.type()) {
+    case NumberType::UnsignedInteger:
+      if (result.setInteger(number.asUnsignedInteger(), resources))
+        return DeserializationError::Ok;
+      else
+        return DeserializationError::NoMemory;
+
+    case NumberType::SignedInteger:
+      if (result.setInteger(number.asSignedInteger(), resources))
+        return DeserializationError::Ok;
+      else
+        return DeserializationError::NoMemory;
+
+    case NumberType::Float:
+      if (result.setFloat(number.asFloat(), resources))
+        return DeserializationError::Ok;
+      else
+        return DeserializationError::NoMemory;
+
+#if ARDUINOJSON_USE_DOUBLE
+    case NumberType::Double:
+      if (result.setFloat(number.asDouble(), resources))
+        return DeserializationError::Ok;
+      else
+        return DeserializationError::NoMemory;
+#endif
+
+    default:
+      return DeserializationError::InvalidInput;
+  }
+}
+
+// Returns the first character of a quoted string that needs processing (see
+// Scanner::skipPlainChars()); deserializeJsonIndexed() overloads it
+template <typename TReader>
+inline const char* scanPlainChars(TReader& reader, const char* p,
+                                  char stopChar) {
+  return Scanner::skipPlainChars(p, reader.end(), stopChar);
+}
+
 template <typename TReader>
 class JsonDeserializer {
  public:
@@ -42,6 +117,75 @@ class JsonDeserializer {
     return err;
   }
 
+  // Parses the next value of a sequence, such as NDJSON.
+  // Unlike parse(), it accepts a number followed by a space, since spaces
+  // separate the values.
+  template <typename TFilter>
+  DeserializationError parseNext(
+      VariantData& variant, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    foundSomething_ = false;
+    return parseVariant(variant, filter, nestingLimit);
+  }
+
+  // Parses comma-separated elements until the end of the input.
+  // deserializeJsonParallel() calls it for each chunk of the array at the
+  // root, so the filter and the nesting limit are those of this array.
+  template <typename TFilter>
+  DeserializationError parseElements(
+      VariantData& variant, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    ArrayData& array = variant.toArray();
+    TFilter elementFilter = filter[0UL];
+
+    for (;;) {
+      if (elementFilter.allow()) {
+        VariantData* value = array.addElement(resources_);
+        if (!value)
+          return DeserializationError::NoMemory;
+        err = parseVariant(*value, elementFilter, nestingLimit.decrement());
+      } else {
+        err = skipVariant(nestingLimit.decrement());
+      }
+      if (err)
+        return err;
+
+      err = skipSpacesAndComments();
+      if (err == DeserializationError::IncompleteInput)
+        return DeserializationError::Ok;  // the chunk ends after an element
+      if (err)
+        return err;
+
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  // Gives back the string buffer, which may belong to the pools of the
+  // document, so the document can be cleared between two values
+  void releaseStringBuffer() {
+    stringBuilder_.release();
+  }
+
+  // Skips the rest of the line, to resume after an invalid value
+  void skipLine() {
+    for (;;) {
+      char c = current();
+      if (c == '\0')
+        return;
+      move();
+      if (c == '\n')
+        return;
+    }
+  }
+
+  DeserializationError parse(JsonHandler& handler,
+                             DeserializationOption::NestingLimit nestingLimit) {
+    return parseVariant(handler, nestingLimit);
+  }
+
  private:
   char current() {
     return latch_.current();
@@ -52,12 +196,88 @@ class JsonDeserializer {
   }
 
   bool eat(char charToSkip) {
-    if (current() != charToSkip)
+    return eat(latch_, charToSkip);
+  }
+
+  // The skip functions take the latch as a parameter, so they also work with
+  // a PointerLatch (see skipInPlace())
+  template <typename TLatch>
+  static bool eat(TLatch& latch, char charToSkip) {
+    if (latch.current() != charToSkip)
       return false;
-    move();
+    latch.clear();
     return true;
   }
 
+  const char* skipPlainChars(char stopChar, size_t& n) {
+    return skipPlainChars(latch_, stopChar, n);
+  }
+
+  // Skips the characters of a quoted string that need no processing, and
+  // returns the first one (or null if the reader isn't contiguous).
+  // Sets `n` to the number of characters skipped.
+  template <typename TLatch>
+  static enable_if_t<is_contiguous_reader<typename TLatch::reader_type>::value,
+                     const char*>
+  skipPlainChars(TLatch& latch, char stopChar, size_t& n) {
+    n = 0;
+    auto reader = latch.reader();
+    if (!reader)
+      return nullptr;
+    auto begin = reader->cursor();
+    n = size_t(scanPlainChars(*reader, begin, stopChar) - begin);
+    reader->setCursor(begin + n);
+    return begin;
+  }
+
+  template <typename TLatch>
+  static enable_if_t<!is_contiguous_reader<typename TLatch::reader_type>::value,
+                     const char*>
+  skipPlainChars(TLatch&, char, size_t& n) {
+    n = 0;
+    return nullptr;
+  }
+
+  template <typename TLatch>
+  static enable_if_t<is_contiguous_reader<typename TLatch::reader_type>::value>
+  skipPlainSpaces(TLatch& latch) {
+    auto reader = latch.reader();
+    if (reader) {
+      auto begin = reader->cursor();
+      auto n = Scanner::skipSpaces(begin, reader->end()) - begin;
+      reader->setCursor(begin + n);
+    }
+  }
+
+  template <typename TLatch>
+  static enable_if_t<!is_contiguous_reader<typename TLatch::reader_type>::value>
+  skipPlainSpaces(TLatch&) {}
+
+  // Skips the value straight from the buffer with a PointerLatch, unless the
+  // reader isn't contiguous, a character is pending in the latch, or nothing
+  // was found yet (in which case the end of the input is EmptyInput rather
+  // than IncompleteInput).
+  // Returns false if it didn't skip the value.
+  template <typename R = TReader>
+  enable_if_t<is_contiguous_reader<R>::value, bool> skipInPlace(
+      DeserializationOption::NestingLimit nestingLimit,
+      DeserializationError::Code& err) {
+    auto reader = latch_.reader();
+    if (!reader || !foundSomething_)
+      return false;
+    auto begin = reader->cursor();
+    PointerLatch latch(begin, reader->end());
+    err = skipVariant(latch, nestingLimit);
+    reader->setCursor(begin + (latch.cursor() - begin));
+    return true;
+  }
+
+  template <typename R = TReader>
+  enable_if_t<!is_contiguous_reader<R>::value, bool> skipInPlace(
+      DeserializationOption::NestingLimit, DeserializationError::Code&) {
+    return false;
+  }
+
   template <typename TFilter>
   DeserializationError::Code parseVariant(
       VariantData& variant, TFilter filter,
@@ -73,74 +293,133 @@ class JsonDeserializer {
         if (filter.allowArray())
           return parseArray(variant.toArray(), filter, nestingLimit);
         else
-          return skipArray(nestingLimit);
+          return skipArray(latch_, nestingLimit);
 
       case '{':
         if (filter.allowObject())
           return parseObject(variant.toObject(), filter, nestingLimit);
         else
-          return skipObject(nestingLimit);
+          return skipObject(latch_, nestingLimit);
 
       case '\"':
       case '\'':
         if (filter.allowValue())
           return parseStringValue(variant);
         else
-          return skipQuotedString();
+          return skipQuotedString(latch_);
 
       case 't':
         if (filter.allowValue())
           variant.setBoolean(true);
-        return skipKeyword("true");
+        return skipKeyword(latch_, "true");
 
       case 'f':
         if (filter.allowValue())
           variant.setBoolean(false);
-        return skipKeyword("false");
+        return skipKeyword(latch_, "false");
 
       case 'n':
         // the variant should already by null, except if the same object key was
         // used twice, as in {"a":1,"a":null}
-        return skipKeyword("null");
+        return skipKeyword(latch_, "null");
 
       default:
         if (filter.allowValue())
           return parseNumericValue(variant);
         else
-          return skipNumericValue();
+          return skipNumericValue(latch_);
     }
   }
 
+  // Skips the value in place if possible (see skipInPlace())
   DeserializationError::Code skipVariant(
       DeserializationOption::NestingLimit nestingLimit) {
     DeserializationError::Code err;
 
+    if (skipInPlace(nestingLimit, err))
+      return err;
+    return skipVariant(latch_, nestingLimit);
+  }
+
+  template <typename TLatch>
+  DeserializationError::Code skipVariant(
+      TLatch& latch, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    err = skipSpacesAndComments(latch);
+    if (err)
+      return err;
+
+    switch (latch.current()) {
+      case '[':
+        return skipArray(latch, nestingLimit);
+
+      case '{':
+        return skipObject(latch, nestingLimit);
+
+      case '\"':
+      case '\'':
+        return skipQuotedString(latch);
+
+      case 't':
+        return skipKeyword(latch, "true");
+
+      case 'f':
+        return skipKeyword(latch, "false");
+
+      case 'n':
+        return skipKeyword(latch, "null");
+
+      default:
+        return skipNumericValue(latch);
+    }
+  }
+
+  // Sends the value to the handler instead of storing it
+  DeserializationError::Code parseVariant(
+      JsonHandler& handler, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
     err = skipSpacesAndComments();
     if (err)
       return err;
 
     switch (current()) {
       case '[':
-        return skipArray(nestingLimit);
+        return parseArray(handler, nestingLimit);
 
       case '{':
-        return skipObject(nestingLimit);
+        return parseObject(handler, nestingLimit);
 
       case '\"':
-      case '\'':
-        return skipQuotedString();
+      case '\'': {
+        JsonString value;
+        err = parseQuotedString(value);
+        if (!err)
+          handler.onString(value);
+        return err;
+      }
 
       case 't':
-        return skipKeyword("true");
+        err = skipKeyword(latch_, "true");
+        if (!err)
+          handler.onBoolean(true);
+        return err;
 
       case 'f':
-        return skipKeyword("false");
+        err = skipKeyword(latch_, "false");
+        if (!err)
+          handler.onBoolean(false);
+        return err;
 
       case 'n':
-        return skipKeyword("null");
+        err = skipKeyword(latch_, "null");
+        if (!err)
+          handler.onNull();
+        return err;
 
       default:
-        return skipNumericValue();
+        return parseNumericValue(handler);
     }
   }
 
@@ -199,37 +478,77 @@ class JsonDeserializer {
     }
   }
 
+  template <typename TLatch>
   DeserializationError::Code skipArray(
-      DeserializationOption::NestingLimit nestingLimit) {
+      TLatch& latch, DeserializationOption::NestingLimit nestingLimit) {
     DeserializationError::Code err;
 
     if (nestingLimit.reached())
       return DeserializationError::TooDeep;
 
     // Skip opening braket
-    ARDUINOJSON_ASSERT(current() == '[');
-    move();
+    ARDUINOJSON_ASSERT(latch.current() == '[');
+    latch.clear();
 
     // Read each value
     for (;;) {
       // 1 - Skip value
-      err = skipVariant(nestingLimit.decrement());
+      err = skipVariant(latch, nestingLimit.decrement());
       if (err)
         return err;
 
       // 2 - Skip spaces
-      err = skipSpacesAndComments();
+      err = skipSpacesAndComments(latch);
       if (err)
         return err;
 
       // 3 - More values?
-      if (eat(']'))
+      if (eat(latch, ']'))
         return DeserializationError::Ok;
-      if (!eat(','))
+      if (!eat(latch, ','))
         return DeserializationError::InvalidInput;
     }
   }
 
+  DeserializationError::Code parseArray(
+      JsonHandler& handler, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening braket
+    ARDUINOJSON_ASSERT(current() == '[');
+    move();
+    handler.onStartArray();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Read each value, unless the array is empty
+    if (!eat(']')) {
+      for (;;) {
+        err = parseVariant(handler, nestingLimit.decrement());
+        if (err)
+          return err;
+
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+
+        if (eat(']'))
+          break;
+        if (!eat(','))
+          return DeserializationError::InvalidInput;
+      }
+    }
+
+    handler.onEndArray();
+    return DeserializationError::Ok;
+  }
+
   template <typename TFilter>
   DeserializationError::Code parseObject(
       ObjectData& object, TFilter filter,
@@ -255,7 +574,8 @@ class JsonDeserializer {
     // Read each key value pair
     for (;;) {
       // Parse key
-      err = parseKey();
+      JsonString key;
+      err = parseKey(key);
       if (err)
         return err;
 
@@ -268,18 +588,13 @@ class JsonDeserializer {
       if (!eat(':'))
         return DeserializationError::InvalidInput;
 
-      JsonString key = stringBuilder_.str();
-
-      TFilter memberFilter = filter[key.c_str()];
+      TFilter memberFilter = filter[key];
 
       if (memberFilter.allow()) {
-        auto member = object.getMember(adaptString(key.c_str()), resources_);
+        auto member = object.getMember(adaptString(key), resources_);
         if (!member) {
-          // Save key in memory pool.
-          auto savedKey = stringBuilder_.save();
-
           // Allocate slot in object
-          member = object.addMember(savedKey, resources_);
+          member = addMember(object, key);
           if (!member)
             return DeserializationError::NoMemory;
         } else {
@@ -314,96 +629,282 @@ class JsonDeserializer {
     }
   }
 
+  template <typename TLatch>
   DeserializationError::Code skipObject(
-      DeserializationOption::NestingLimit nestingLimit) {
+      TLatch& latch, DeserializationOption::NestingLimit nestingLimit) {
     DeserializationError::Code err;
 
     if (nestingLimit.reached())
       return DeserializationError::TooDeep;
 
     // Skip opening brace
-    ARDUINOJSON_ASSERT(current() == '{');
-    move();
+    ARDUINOJSON_ASSERT(latch.current() == '{');
+    latch.clear();
 
     // Skip spaces
-    err = skipSpacesAndComments();
+    err = skipSpacesAndComments(latch);
     if (err)
       return err;
 
     // Empty object?
-    if (eat('}'))
+    if (eat(latch, '}'))
       return DeserializationError::Ok;
 
     // Read each key value pair
     for (;;) {
       // Skip key
-      err = skipKey();
+      err = skipKey(latch);
       if (err)
         return err;
 
       // Skip spaces
-      err = skipSpacesAndComments();
+      err = skipSpacesAndComments(latch);
       if (err)
         return err;
 
       // Colon
-      if (!eat(':'))
+      if (!eat(latch, ':'))
         return DeserializationError::InvalidInput;
 
       // Skip value
-      err = skipVariant(nestingLimit.decrement());
+      err = skipVariant(latch, nestingLimit.decrement());
       if (err)
         return err;
 
       // Skip spaces
-      err = skipSpacesAndComments();
+      err = skipSpacesAndComments(latch);
       if (err)
         return err;
 
       // More keys/values?
-      if (eat('}'))
+      if (eat(latch, '}'))
         return DeserializationError::Ok;
-      if (!eat(','))
+      if (!eat(latch, ','))
         return DeserializationError::InvalidInput;
 
-      err = skipSpacesAndComments();
+      err = skipSpacesAndComments(latch);
       if (err)
         return err;
     }
   }
 
-  DeserializationError::Code parseKey() {
-    stringBuilder_.startString();
+  DeserializationError::Code parseObject(
+      JsonHandler& handler, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening brace
+    ARDUINOJSON_ASSERT(current() == '{');
+    move();
+    handler.onStartObject();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Read each key value pair, unless the object is empty
+    if (!eat('}')) {
+      for (;;) {
+        JsonString key;
+        err = parseKey(key);
+        if (err)
+          return err;
+        handler.onKey(key);
+
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+
+        if (!eat(':'))
+          return DeserializationError::InvalidInput;
+
+        err = parseVariant(handler, nestingLimit.decrement());
+        if (err)
+          return err;
+
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+
+        if (eat('}'))
+          break;
+        if (!eat(','))
+          return DeserializationError::InvalidInput;
+
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+      }
+    }
+
+    handler.onEndObject();
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code parseKey(JsonString& key) {
     if (isQuote(current())) {
-      return parseQuotedString();
+      return parseQuotedString(key);
     } else {
-      return parseNonQuotedString();
+      return parseNonQuotedString(key);
     }
   }
 
   DeserializationError::Code parseStringValue(VariantData& variant) {
     DeserializationError::Code err;
+    JsonString value;
+
+    err = parseQuotedString(value);
+    if (err)
+      return err;
+
+    if (isInStringBuilder(value))
+      variant.setOwnedString(stringBuilder_.save());
+    else if (!variant.setString(adaptString(value), resources_))
+      return DeserializationError::NoMemory;
+
+    return DeserializationError::Ok;
+  }
+
+  // Adds the key returned by parseKey() to the object
+  VariantData* addMember(ObjectData& object, JsonString key) {
+    if (isInStringBuilder(key))
+      return object.addMember(stringBuilder_.save(), resources_);
+    else
+      return object.addMember(adaptString(key), resources_);
+  }
+
+  // Strings are unescaped in the StringBuilder, except in the following
+  // cases: in in-situ mode, they are linked to the input; in copy-from-input
+  // mode, the ones without escape sequences are saved straight from the input.
+  bool isInStringBuilder(JsonString s) const {
+    return !(is_same<TReader, InSituReader>::value ||
+             is_copy_from_input_reader<TReader>::value) ||
+           stringBuilder_.holds(s);
+  }
+
+  // Unescapes the string in the StringBuilder (see isInStringBuilder())
+  template <typename R = TReader>
+  enable_if_t<!is_same<R, InSituReader>::value, DeserializationError::Code>
+  parseQuotedString(JsonString& result) {
+    DeserializationError::Code err;
+
+    const char stopChar = current();
+    move();
+
+    size_t n;
+    const char* run = skipPlainChars(stopChar, n);
+    if (is_copy_from_input_reader<TReader>::value && run &&
+        current() == stopChar) {
+      move();  // no escape sequence, the string can be saved from the input
+      result = JsonString(run, n, JsonString::Copied);
+      return DeserializationError::Ok;
+    }
 
     stringBuilder_.startString();
+    if (n)
+      stringBuilder_.append(run, n);
 
-    err = parseQuotedString();
+    err = unescapeString(stopChar, stringBuilder_);
     if (err)
       return err;
 
-    variant.setOwnedString(stringBuilder_.save());
+    if (!stringBuilder_.isValid())
+      return DeserializationError::NoMemory;
 
+    result = stringBuilder_.str();
     return DeserializationError::Ok;
   }
 
-  DeserializationError::Code parseQuotedString() {
+  // Unescapes the string in the input buffer (in-situ mode)
+  template <typename R = TReader>
+  enable_if_t<is_same<R, InSituReader>::value, DeserializationError::Code>
+  parseQuotedString(JsonString& result) {
+    DeserializationError::Code err;
+
+    const char stopChar = current();
+    move();
+
+    ARDUINOJSON_ASSERT(latch_.reader() != nullptr);
+    InSituString str(latch_.reader()->cursor());
+
+    err = unescapeString(stopChar, str);
+    if (err)
+      return err;
+
+    if (!str.containsNull()) {
+      result = str.terminate();
+      return DeserializationError::Ok;
+    }
+
+    // a linked string can't contain '\0', so we must copy this one
+    stringBuilder_.startString();
+    stringBuilder_.append(str.data(), str.size());
+    if (!stringBuilder_.isValid())
+      return DeserializationError::NoMemory;
+
+    result = stringBuilder_.str();
+    return DeserializationError::Ok;
+  }
+
+  // Writes the unescaped string over the escaped one.
+  // Never overtakes the reader because escape sequences are longer than the
+  // characters they represent.
+  class InSituString {
+   public:
+    InSituString(char* data) : data_(data), size_(0), containsNull_(false) {}
+
+    void append(char c) {
+      if (c == '\0')
+        containsNull_ = true;
+      data_[size_++] = c;
+    }
+
+    void append(const char* s, size_t n) {
+      if (s != data_ + size_)
+        memmove(data_ + size_, s, n);
+      size_ += n;
+    }
+
+    bool containsNull() const {
+      return containsNull_;
+    }
+
+    const char* data() const {
+      return data_;
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    JsonString terminate() {
+      data_[size_] = 0;  // replaces the closing quote (or an earlier char)
+      return JsonString(data_, size_, JsonString::Linked);
+    }
+
+   private:
+    char* data_;
+    size_t size_;
+    bool containsNull_;
+  };
+
+  // Reads the characters after the opening quote, and writes the unescaped
+  // string to the sink
+  template <typename TSink>
+  DeserializationError::Code unescapeString(char stopChar, TSink& sink) {
 #if ARDUINOJSON_DECODE_UNICODE
     Utf16::Codepoint codepoint;
     DeserializationError::Code err;
 #endif
-    const char stopChar = current();
-
-    move();
     for (;;) {
+      size_t n;
+      const char* run = skipPlainChars(stopChar, n);
+      if (n)
+        sink.append(run, n);
+
       char c = current();
       move();
       if (c == stopChar)
@@ -426,9 +927,9 @@ class JsonDeserializer {
           if (err)
             return err;
           if (codepoint.append(codeunit))
-            Utf8::encodeCodepoint(codepoint.value(), stringBuilder_);
+            Utf8::encodeCodepoint(codepoint.value(), sink);
 #else
-          stringBuilder_.append('\\');
+          sink.append('\\');
 #endif
           continue;
         }
@@ -440,19 +941,18 @@ class JsonDeserializer {
         move();
       }
 
-      stringBuilder_.append(c);
+      sink.append(c);
     }
 
-    if (!stringBuilder_.isValid())
-      return DeserializationError::NoMemory;
-
     return DeserializationError::Ok;
   }
 
-  DeserializationError::Code parseNonQuotedString() {
+  DeserializationError::Code parseNonQuotedString(JsonString& result) {
     char c = current();
     ARDUINOJSON_ASSERT(c);
 
+    stringBuilder_.startString();
+
     if (canBeInNonQuotedString(c)) {  // no quotes
       do {
         move();
@@ -466,83 +966,78 @@ class JsonDeserializer {
     if (!stringBuilder_.isValid())
       return DeserializationError::NoMemory;
 
+    result = stringBuilder_.str();
     return DeserializationError::Ok;
   }
 
-  DeserializationError::Code skipKey() {
-    if (isQuote(current())) {
-      return skipQuotedString();
+  template <typename TLatch>
+  DeserializationError::Code skipKey(TLatch& latch) {
+    if (isQuote(latch.current())) {
+      return skipQuotedString(latch);
     } else {
-      return skipNonQuotedString();
+      return skipNonQuotedString(latch);
     }
   }
 
-  DeserializationError::Code skipQuotedString() {
-    const char stopChar = current();
+  template <typename TLatch>
+  DeserializationError::Code skipQuotedString(TLatch& latch) {
+    const char stopChar = latch.current();
 
-    move();
+    latch.clear();
     for (;;) {
-      char c = current();
-      move();
+      size_t n;
+      skipPlainChars(latch, stopChar, n);
+
+      char c = latch.current();
+      latch.clear();
       if (c == stopChar)
         break;
       if (c == '\0')
         return DeserializationError::IncompleteInput;
       if (c == '\\') {
-        if (current() != '\0')
-          move();
+        if (latch.current() != '\0')
+          latch.clear();
       }
     }
 
     return DeserializationError::Ok;
   }
 
-  DeserializationError::Code skipNonQuotedString() {
-    char c = current();
+  template <typename TLatch>
+  DeserializationError::Code skipNonQuotedString(TLatch& latch) {
+    char c = latch.current();
     while (canBeInNonQuotedString(c)) {
-      move();
-      c = current();
+      latch.clear();
+      c = latch.current();
     }
     return DeserializationError::Ok;
   }
 
   DeserializationError::Code parseNumericValue(VariantData& result) {
-    uint8_t n = 0;
-
-    char c = current();
-    while (canBeInNumber(c) && n < 63) {
-      move();
-      buffer_[n++] = c;
-      c = current();
-    }
-    buffer_[n] = 0;
+    readNumber();
+    return setNumericValue(result, buffer_, resources_);
+  }
 
+  DeserializationError::Code parseNumericValue(JsonHandler& handler) {
+    readNumber();
     auto number = parseNumber(buffer_);
     switch (number.type()) {
       case NumberType::UnsignedInteger:
-        if (result.setInteger(number.asUnsignedInteger(), resources_))
-          return DeserializationError::Ok;
-        else
-          return DeserializationError::NoMemory;
+        handler.onUnsignedInteger(number.asUnsignedInteger());
+        return DeserializationError::Ok;
 
       case NumberType::SignedInteger:
-        if (result.setInteger(number.asSignedInteger(), resources_))
-          return DeserializationError::Ok;
-        else
-          return DeserializationError::NoMemory;
+        handler.onInteger(number.asSignedInteger());
+        return DeserializationError::Ok;
 
       case NumberType::Float:
-        if (result.setFloat(number.asFloat(), resources_))
-          return DeserializationError::Ok;
-        else
-          return DeserializationError::NoMemory;
+        handler.onFloat(number.asFloat());
+        return DeserializationError::Ok;
 
 #if ARDUINOJSON_USE_DOUBLE
       case NumberType::Double:
-        if (result.setFloat(number.asDouble(), resources_))
-          return DeserializationError::Ok;
-        else
-          return DeserializationError::NoMemory;
+        handler.onFloat(number.asDouble());
+        return DeserializationError::Ok;
 #endif
 
       default:
@@ -550,12 +1045,26 @@ class JsonDeserializer {
     }
   }
 
-  DeserializationError::Code skipNumericValue() {
+  // Copies the characters of the number to buffer_
+  void readNumber() {
+    uint8_t n = 0;
+
     char c = current();
-    while (canBeInNumber(c)) {
+    while (canBeInNumber(c) && n < 63) {
       move();
+      buffer_[n++] = c;
       c = current();
     }
+    buffer_[n] = 0;
+  }
+
+  template <typename TLatch>
+  DeserializationError::Code skipNumericValue(TLatch& latch) {
+    char c = latch.current();
+    while (canBeInNumber(c)) {
+      latch.clear();
+      c = latch.current();
+    }
     return DeserializationError::Ok;
   }
 
@@ -574,38 +1083,15 @@ class JsonDeserializer {
     return DeserializationError::Ok;
   }
 
-  static inline bool isBetween(char c, char min, char max) {
-    return min <= c && c <= max;
-  }
-
-  static inline bool canBeInNumber(char c) {
-    return isBetween(c, '0', '9') || c == '+' || c == '-' || c == '.' ||
-#if ARDUINOJSON_ENABLE_NAN || ARDUINOJSON_ENABLE_INFINITY
-           isBetween(c, 'A', 'Z') || isBetween(c, 'a', 'z');
-#else
-           c == 'e' || c == 'E';
-#endif
-  }
-
-  static inline bool canBeInNonQuotedString(char c) {
-    return isBetween(c, '0', '9') || isBetween(c, '_', 'z') ||
-           isBetween(c, 'A', 'Z');
-  }
-
-  static inline bool isQuote(char c) {
-    return c == '\'' || c == '\"';
-  }
-
-  static inline uint8_t decodeHex(char c) {
-    if (c < 'A')
-      return uint8_t(c - '0');
-    c = char(c & ~0x20);  // uppercase
-    return uint8_t(c - 'A' + 10);
+  DeserializationError::Code skipSpacesAndComments() {
+    return skipSpacesAndComments(latch_);
   }
 
-  DeserializationError::Code skipSpacesAndComments() {
+  template <typename TLatch>
+  DeserializationError::Code skipSpacesAndComments(TLatch& latch) {
     for (;;) {
-      switch (current()) {
+      skipPlainSpaces(latch);
+      switch (latch.current()) {
         // end of string
         case '\0':
           return foundSomething_ ? DeserializationError::IncompleteInput
@@ -616,28 +1102,28 @@ class JsonDeserializer {
         case '\t':
         case '\r':
         case '\n':
-          move();
+          latch.clear();
           continue;
 
 #if ARDUINOJSON_ENABLE_COMMENTS
         // comments
         case '/':
-          move();  // skip '/'
-          switch (current()) {
+          latch.clear();  // skip '/'
+          switch (latch.current()) {
             // block comment
             case '*': {
-              move();  // skip '*'
+              latch.clear();  // skip '*'
               bool wasStar = false;
               for (;;) {
-                char c = current();
+                char c = latch.current();
                 if (c == '\0')
                   return DeserializationError::IncompleteInput;
                 if (c == '/' && wasStar) {
-                  move();
+                  latch.clear();
                   break;
                 }
                 wasStar = c == '*';
-                move();
+                latch.clear();
               }
               break;
             }
@@ -646,8 +1132,8 @@ class JsonDeserializer {
             case '/':
               // no need to skip "//"
               for (;;) {
-                move();
-                char c = current();
+                latch.clear();
+                char c = latch.current();
                 if (c == '\0')
                   return DeserializationError::IncompleteInput;
                 if (c == '\n')
@@ -669,15 +1155,16 @@ class JsonDeserializer {
     }
   }
 
-  DeserializationError::Code skipKeyword(const char* s) {
+  template <typename TLatch>
+  DeserializationError::Code skipKeyword(TLatch& latch, const char* s) {
     while (*s) {
-      char c = current();
+      char c = latch.current();
       if (c == '\0')
         return DeserializationError::IncompleteInput;
       if (*s != c)
         return DeserializationError::InvalidInput;
       ++s;
-      move();
+      latch.clear();
     }
     return DeserializationError::Ok;
   }
@@ -691,6 +1178,9 @@ class JsonDeserializer {
                      // code
 };
 
+template <>
+struct supports_input_modes<JsonDeserializer> : true_type {};
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
 
 ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
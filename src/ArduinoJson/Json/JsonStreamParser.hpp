@@ -0,0 +1,504 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Parses a JSON input that arrives in chunks, and puts the result in a
+// JsonDocument.
+// Unlike deserializeJson(), it doesn't pull the characters from a reader: you
+// push them with feed(), and it builds the document as they come.
+// It keeps the stack of open arrays and objects in a member, so it doesn't
+// recurse; the nesting limit is ARDUINOJSON_DEFAULT_NESTING_LIMIT.
+class JsonStreamParser {
+ public:
+  enum Status {
+    NeedMoreData,  // the value is incomplete, call feed() again
+    Done,          // the value is complete, see consumed()
+    Error,         // the input is invalid, see error()
+  };
+
+  explicit JsonStreamParser(JsonDocument& doc)
+      : doc_(doc),
+        resources_(detail::VariantAttorney::getResourceManager(doc)),
+        stringBuilder_(resources_) {
+    reset();
+  }
+
+  JsonStreamParser(const JsonStreamParser&) = delete;
+  JsonStreamParser& operator=(const JsonStreamParser&) = delete;
+
+  // Empties the document, and prepares for a new value
+  void reset() {
+    stringBuilder_.release();
+    doc_.reset();
+    root_ = detail::VariantAttorney::getOrCreateData(doc_);
+    value_ = nullptr;
+    depth_ = 0;
+    state_ = State::Value;
+    error_ = DeserializationError::Ok;
+    foundSomething_ = false;
+    consumed_ = 0;
+  }
+
+  // Parses the next chunk of the input.
+  // Stops at the end of the value, so the remaining characters can belong to
+  // the next one.
+  Status feed(const char* input, size_t n) {
+    const char* p = input;
+    const char* end = input + n;
+    while (p != end && !finished()) {
+      if (*p == '\0') {  // like deserializeJson(), stop at the terminator
+        consumed_ = size_t(p - input);
+        return finish();
+      }
+      p = parse(p, end);
+    }
+    consumed_ = size_t(p - input);
+    return status();
+  }
+
+  Status feed(const char* input) {
+    return feed(input, strlen(input));
+  }
+
+  // Tells that the input is over.
+  // Completes a number at the root (as in "42"), or fails with
+  // EmptyInput or IncompleteInput.
+  Status finish() {
+    if (finished())
+      return status();
+    if (state_ == State::Number && depth_ == 0)
+      return fail(endNumber());
+    if (foundSomething_ || isInComment())
+      return fail(DeserializationError::IncompleteInput);
+    return fail(DeserializationError::EmptyInput);
+  }
+
+  Status status() const {
+    switch (state_) {
+      case State::Done:
+        return Done;
+      case State::Failed:
+        return Error;
+      default:
+        return NeedMoreData;
+    }
+  }
+
+  DeserializationError error() const {
+    return error_;
+  }
+
+  // Returns the number of characters of the last chunk that feed() parsed
+  size_t consumed() const {
+    return consumed_;
+  }
+
+ private:
+  enum class State : uint8_t {
+    Value,
+    FirstElement,  // after '['
+    FirstMember,   // after '{'
+    Key,
+    Colon,
+    Separator,  // after a value in an array or an object
+    String,
+    Escape,
+    Unicode,
+    UnquotedKey,
+    Number,
+    Keyword,
+#if ARDUINOJSON_ENABLE_COMMENTS
+    Slash,
+    BlockComment,
+    BlockCommentStar,
+    LineComment,
+#endif
+    Done,
+    Failed,
+  };
+
+  bool finished() const {
+    return state_ == State::Done || state_ == State::Failed;
+  }
+
+  bool isInComment() const {
+#if ARDUINOJSON_ENABLE_COMMENTS
+    return state_ == State::Slash || state_ == State::BlockComment ||
+           state_ == State::BlockCommentStar || state_ == State::LineComment;
+#else
+    return false;
+#endif
+  }
+
+  // Processes the characters from p, and returns the first one not consumed
+  const char* parse(const char* p, const char* end) {
+    DeserializationError::Code err = DeserializationError::Ok;
+
+    switch (state_) {
+      case State::Value:
+      case State::FirstElement:
+      case State::FirstMember:
+      case State::Key:
+      case State::Colon:
+      case State::Separator:
+        p = detail::Scanner::skipSpaces(p, end);
+        if (p == end)
+          return p;
+#if ARDUINOJSON_ENABLE_COMMENTS
+        if (*p == '/') {
+          savedState_ = state_;
+          state_ = State::Slash;
+          return p + 1;
+        }
+#endif
+        break;
+
+      case State::String:
+        return parseString(p, end);
+
+      default:
+        break;
+    }
+
+    char c = *p;
+
+    switch (state_) {
+      case State::Value:
+        if (depth_ == 0)
+          foundSomething_ = true;
+        return parseValue(p);
+
+      case State::FirstElement:
+        if (c == ']')
+          return endContainer(p);
+        state_ = State::Value;
+        return p;
+
+      case State::FirstMember:
+        if (c == '}')
+          return endContainer(p);
+        state_ = State::Key;
+        return p;
+
+      case State::Key:
+        stringBuilder_.startString();
+        inKey_ = true;
+        if (detail::isQuote(c))
+          return startString(p);
+        if (!detail::canBeInNonQuotedString(c))
+          return fail(DeserializationError::InvalidInput, p);
+        state_ = State::UnquotedKey;
+        return p;
+
+      case State::Colon:
+        if (c != ':')
+          return fail(DeserializationError::InvalidInput, p);
+        state_ = State::Value;
+        return p + 1;
+
+      case State::Separator:
+        if (c == (top()->isArray() ? ']' : '}'))
+          return endContainer(p);
+        if (c != ',')
+          return fail(DeserializationError::InvalidInput, p);
+        state_ = top()->isArray() ? State::Value : State::Key;
+        return p + 1;
+
+      case State::Escape:
+        state_ = State::String;
+        if (c == 'u') {
+#if ARDUINOJSON_DECODE_UNICODE
+          state_ = State::Unicode;
+          codeunit_ = 0;
+          length_ = 0;
+          return p + 1;
+#else
+          stringBuilder_.append('\\');
+          return p;  // the 'u' is appended as a regular character
+#endif
+        }
+        c = detail::EscapeSequence::unescapeChar(c);
+        if (c == '\0')
+          return fail(DeserializationError::InvalidInput, p);
+        stringBuilder_.append(c);
+        return p + 1;
+
+#if ARDUINOJSON_DECODE_UNICODE
+      case State::Unicode: {
+        uint8_t digit = detail::decodeHex(c);
+        if (digit > 0x0F)
+          return fail(DeserializationError::InvalidInput, p);
+        codeunit_ = uint16_t((codeunit_ << 4) | digit);
+        if (++length_ == 4) {
+          if (codepoint_.append(codeunit_))
+            detail::Utf8::encodeCodepoint(codepoint_.value(), stringBuilder_);
+          state_ = State::String;
+        }
+        return p + 1;
+      }
+#endif
+
+      case State::UnquotedKey:
+        if (detail::canBeInNonQuotedString(c)) {
+          stringBuilder_.append(c);
+          return p + 1;
+        }
+        err = endKey();
+        break;
+
+      case State::Number:
+        if (detail::canBeInNumber(c) && length_ < sizeof(buffer_) - 1) {
+          buffer_[length_++] = c;
+          return p + 1;
+        }
+        err = endNumber();
+        break;
+
+      case State::Keyword:
+        if (c != *keyword_)
+          return fail(DeserializationError::InvalidInput, p);
+        if (*++keyword_ == '\0')
+          endValue();
+        return p + 1;
+
+#if ARDUINOJSON_ENABLE_COMMENTS
+      case State::Slash:
+        if (c == '*')
+          state_ = State::BlockComment;
+        else if (c == '/')
+          state_ = State::LineComment;
+        else
+          return fail(DeserializationError::InvalidInput, p);
+        return p + 1;
+
+      case State::BlockComment:
+        if (c == '*')
+          state_ = State::BlockCommentStar;
+        return p + 1;
+
+      case State::BlockCommentStar:
+        if (c == '/')
+          state_ = savedState_;
+        else if (c != '*')
+          state_ = State::BlockComment;
+        return p + 1;
+
+      case State::LineComment:
+        if (c == '\n')
+          state_ = savedState_;
+        return p + 1;
+#endif
+
+      default:
+        ARDUINOJSON_ASSERT(false);
+        break;
+    }
+
+    if (err)
+      return fail(err, p);
+    return p;  // the terminating character still needs to be processed
+  }
+
+  const char* parseValue(const char* p) {
+    char c = *p;
+
+    if (c == '[' || c == '{') {
+      if (depth_ == ARDUINOJSON_DEFAULT_NESTING_LIMIT)
+        return fail(DeserializationError::TooDeep, p);
+      auto container = newValue();
+      if (!container)
+        return fail(DeserializationError::NoMemory, p);
+      if (c == '[')
+        container->toArray();
+      else
+        container->toObject();
+      stack_[depth_++] = container;
+      state_ = c == '[' ? State::FirstElement : State::FirstMember;
+      return p + 1;
+    }
+
+    value_ = newValue();
+    if (!value_)
+      return fail(DeserializationError::NoMemory, p);
+
+    switch (c) {
+      case '\"':
+      case '\'':
+        stringBuilder_.startString();
+        inKey_ = false;
+        return startString(p);
+
+      case 't':
+        value_->setBoolean(true);
+        return startKeyword("true", p);
+
+      case 'f':
+        value_->setBoolean(false);
+        return startKeyword("false", p);
+
+      case 'n':
+        return startKeyword("null", p);
+
+      default:
+        state_ = State::Number;
+        length_ = 0;
+        return p;
+    }
+  }
+
+  // Returns the variant that receives the next value
+  detail::VariantData* newValue() {
+    if (depth_ == 0)
+      return root_;
+    if (top()->isArray())
+      return top()->addElement(resources_);
+    return value_;  // the member created by endKey()
+  }
+
+  detail::VariantData* top() {
+    ARDUINOJSON_ASSERT(depth_ > 0);
+    return stack_[depth_ - 1];
+  }
+
+  const char* startString(const char* p) {
+    quote_ = *p;
+#if ARDUINOJSON_DECODE_UNICODE
+    codepoint_ = detail::Utf16::Codepoint();
+#endif
+    state_ = State::String;
+    return p + 1;
+  }
+
+  const char* parseString(const char* p, const char* end) {
+    const char* run = p;
+    p = detail::Scanner::skipPlainChars(p, end, quote_);
+    if (p != run)
+      stringBuilder_.append(run, size_t(p - run));
+    if (p == end)
+      return p;
+
+    char c = *p;
+    if (c == quote_) {
+      auto err = inKey_ ? endKey() : endString();
+      if (err)
+        return fail(err, p);
+      return p + 1;
+    }
+    if (c == '\\')
+      state_ = State::Escape;
+    else if (c != '\0')  // control characters are kept as is
+      stringBuilder_.append(c);
+    else
+      return p;  // the terminator is handled by feed()
+    return p + 1;
+  }
+
+  DeserializationError::Code endString() {
+    if (!stringBuilder_.isValid())
+      return DeserializationError::NoMemory;
+    value_->setOwnedString(stringBuilder_.save());
+    endValue();
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code endKey() {
+    if (!stringBuilder_.isValid())
+      return DeserializationError::NoMemory;
+    auto object = top()->asObject();
+    ARDUINOJSON_ASSERT(object != nullptr);
+    auto key = stringBuilder_.str();
+    value_ = object->getMember(detail::adaptString(key), resources_);
+    if (value_)
+      value_->clear(resources_);  // as in {"a":1,"a":2}
+    else
+      value_ = object->addMember(stringBuilder_.save(), resources_);
+    if (!value_)
+      return DeserializationError::NoMemory;
+    state_ = State::Colon;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code endNumber() {
+    buffer_[length_] = 0;
+    auto err = detail::setNumericValue(*value_, buffer_, resources_);
+    if (!err)
+      endValue();
+    return err;
+  }
+
+  const char* startKeyword(const char* keyword, const char* p) {
+    keyword_ = keyword + 1;
+    state_ = State::Keyword;
+    return p + 1;
+  }
+
+  const char* endContainer(const char* p) {
+    depth_--;
+    endValue();
+    return p + 1;
+  }
+
+  void endValue() {
+    if (depth_ == 0) {
+      state_ = State::Done;
+      release();
+    } else {
+      state_ = State::Separator;
+    }
+  }
+
+  const char* fail(DeserializationError::Code err, const char* p) {
+    fail(err);
+    return p;
+  }
+
+  Status fail(DeserializationError::Code err) {
+    if (err) {
+      error_ = err;
+      state_ = State::Failed;
+      release();
+    }
+    return status();
+  }
+
+  // Gives back the memory of the StringBuilder, as deserializeJson() does
+  void release() {
+    stringBuilder_.release();
+#if ARDUINOJSON_AUTO_SHRINK
+    doc_.shrinkToFit();
+#endif
+  }
+
+  JsonDocument& doc_;
+  detail::ResourceManager* resources_;
+  detail::StringBuilder stringBuilder_;
+  detail::VariantData* root_;
+  detail::VariantData* value_;  // the variant being parsed
+  detail::VariantData* stack_[ARDUINOJSON_DEFAULT_NESTING_LIMIT];
+  uint8_t depth_;
+  State state_;
+#if ARDUINOJSON_ENABLE_COMMENTS
+  State savedState_;  // the state to restore after a comment
+#endif
+  DeserializationError::Code error_;
+  bool foundSomething_;
+  bool inKey_;
+  char quote_;
+  uint8_t length_;  // of the number, or of the \u escape sequence
+  const char* keyword_;  // the remaining characters of true, false, or null
+#if ARDUINOJSON_DECODE_UNICODE
+  uint16_t codeunit_;
+  detail::Utf16::Codepoint codepoint_;
+#endif
+  size_t consumed_;
+  char buffer_[64];
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
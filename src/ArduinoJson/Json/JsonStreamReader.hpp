@@ -0,0 +1,103 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Reads the values of a sequence, such as NDJSON, one at a time.
+// The reader and the memory pools of the document are reused from one value
+// to the next. The string buffer is released after each value, so the
+// document can be cleared between two calls.
+template <typename TReader, typename TOptions>
+class JsonStreamReader {
+ public:
+  JsonStreamReader(JsonDocument& doc, TReader reader, TOptions options)
+      : doc_(doc),
+        deserializer_(VariantAttorney::getResourceManager(doc), reader),
+        options_(options),
+        ended_(false) {}
+
+  // Replaces the content of the document with the next value.
+  // Returns EmptyInput at the end of the input.
+  // After any other error, it skips the rest of the line, so you can call
+  // next() again to read the value on the following line; the values that
+  // follow the invalid one on the same line are lost.
+  DeserializationError next() {
+    if (ended_)
+      return DeserializationError::EmptyInput;
+
+    doc_.reset();  // keeps the memory pools, even with ARDUINOJSON_AUTO_SHRINK
+    auto data = VariantAttorney::getOrCreateData(doc_);
+    if (!data)
+      return DeserializationError::NoMemory;
+
+    auto err = deserializer_.parseNext(*data, options_.filter,
+                                       options_.nestingLimit);
+    switch (err.code()) {
+      case DeserializationError::Ok:
+        break;
+
+      case DeserializationError::EmptyInput:
+      case DeserializationError::IncompleteInput:
+        ended_ = true;  // the reader may be past the end of the input
+        break;
+
+      default:
+        deserializer_.skipLine();
+        break;
+    }
+    deserializer_.releaseStringBuffer();
+    return err;
+  }
+
+ private:
+  JsonDocument& doc_;
+  JsonDeserializer<TReader> deserializer_;
+  TOptions options_;
+  bool ended_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Reads a sequence of JSON values, such as NDJSON, one value at a time.
+// Call next() on the returned object to put the next value in the document.
+// After an error, next() resumes at the following line, so it can't recover
+// from an invalid value in concatenated values like {"a":x}{"b":1}.
+// The input must remain valid as long as the returned object is used.
+template <typename TInput, typename... Args,
+          typename = detail::enable_if_t<!detail::is_integral<
+              typename detail::first_or_void<Args...>::type>::value>>
+auto deserializeJsonSequence(JsonDocument& doc, TInput&& input, Args... args)
+    -> detail::JsonStreamReader<
+        decltype(detail::makeReader(detail::forward<TInput>(input))),
+        decltype(detail::makeDeserializationOptions(args...))> {
+  using namespace detail;
+  return {doc, makeReader(detail::forward<TInput>(input)),
+          makeDeserializationOptions(args...)};
+}
+
+// Reads a sequence of JSON values, such as NDJSON, one value at a time.
+// Call next() on the returned object to put the next value in the document.
+// After an error, next() resumes at the following line, so it can't recover
+// from an invalid value in concatenated values like {"a":x}{"b":1}.
+// The input must remain valid as long as the returned object is used.
+template <typename TChar, typename Size, typename... Args,
+          typename = detail::enable_if_t<detail::is_integral<Size>::value>>
+auto deserializeJsonSequence(JsonDocument& doc, TChar* input, Size inputSize,
+                             Args... args)
+    -> detail::JsonStreamReader<
+        decltype(detail::makeReader(input, size_t(inputSize))),
+        decltype(detail::makeDeserializationOptions(args...))> {
+  using namespace detail;
+  return {doc, makeReader(input, size_t(inputSize)),
+          makeDeserializationOptions(args...)};
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -11,6 +11,8 @@ ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 template <typename TReader>
 class Latch {
  public:
+  using reader_type = TReader;
+
   Latch(TReader reader) : reader_(reader), loaded_(false) {
 #if ARDUINOJSON_DEBUG
     ended_ = false;
@@ -32,6 +34,11 @@ class Latch {
     return current_;
   }
 
+  // Gives direct access to the reader, unless a character is pending
+  TReader* reader() {
+    return loaded_ ? nullptr : &reader_;
+  }
+
  private:
   void load() {
     ARDUINOJSON_ASSERT(!ended_);
@@ -53,4 +60,45 @@ class Latch {
 #endif
 };
 
+// Works like a Latch, but reads a contiguous input straight from the buffer,
+// so it doesn't go through the reader one character at a time.
+// It's its own reader, so the functions that use the buffer of the reader
+// (see is_contiguous_reader) also work with it.
+class PointerLatch {
+ public:
+  using reader_type = PointerLatch;
+
+  // `end` is null if the input is null-terminated
+  PointerLatch(const char* ptr, const char* end) : ptr_(ptr), end_(end) {}
+
+  void clear() {
+    if (ptr_ != end_)
+      ptr_++;
+  }
+
+  FORCE_INLINE char current() const {
+    return ptr_ != end_ ? *ptr_ : 0;
+  }
+
+  PointerLatch* reader() {
+    return this;
+  }
+
+  const char* cursor() const {
+    return ptr_;
+  }
+
+  const char* end() const {
+    return end_;
+  }
+
+  void setCursor(const char* ptr) {
+    ptr_ = ptr;
+  }
+
+ private:
+  const char* ptr_;
+  const char* end_;
+};
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,80 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint8_t
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Scans contiguous inputs in place, without going through the Latch.
+// On 32 and 64 bits systems, it tests a word at a time (SWAR); on 8-bit
+// systems, it tests one byte at a time.
+// When `end` is null, the input is null-terminated, so we can't read ahead.
+namespace Scanner {
+#if ARDUINOJSON_SIZEOF_POINTER >= 4
+const size_t wordSize = sizeof(size_t);
+const size_t lowBits = size_t(-1) / 0xFF;  // 0x0101...01
+const size_t highBits = lowBits * 0x80;    // 0x8080...80
+
+inline size_t loadWord(const char* p) {
+  size_t word;
+  memcpy(&word, p, sizeof(word));
+  return word;
+}
+
+// Returns a non-zero value if one of the bytes is less than n (n <= 128)
+inline size_t hasByteLessThan(size_t word, uint8_t n) {
+  return (word - lowBits * n) & ~word & highBits;
+}
+
+// Returns a non-zero value if one of the bytes is equal to c
+inline size_t hasByte(size_t word, char c) {
+  return hasByteLessThan(word ^ (lowBits * uint8_t(c)), 1);
+}
+#endif
+
+inline bool isPlainChar(char c, char quote) {
+  return c != quote && c != '\\' && uint8_t(c) >= 0x20;
+}
+
+// Returns a pointer to the first quote, backslash, or control character
+inline const char* skipPlainChars(const char* p, const char* end, char quote) {
+#if ARDUINOJSON_SIZEOF_POINTER >= 4
+  if (end) {
+    while (size_t(end - p) >= wordSize) {
+      size_t word = loadWord(p);
+      if (hasByte(word, quote) | hasByte(word, '\\') |
+          hasByteLessThan(word, 0x20))
+        break;
+      p += wordSize;
+    }
+  }
+#endif
+  while (p != end && isPlainChar(*p, quote))
+    p++;
+  return p;
+}
+
+// Returns a pointer to the first character that is not a space, a tab, or a
+// line break
+inline const char* skipSpaces(const char* p, const char* end) {
+#if ARDUINOJSON_SIZEOF_POINTER >= 4
+  // indentation is made of spaces, so we only skip words full of spaces
+  if (end) {
+    while (size_t(end - p) >= wordSize && loadWord(p) == lowBits * ' ')
+      p += wordSize;
+  }
+#endif
+  while (p != end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+    p++;
+  return p;
+}
+}  // namespace Scanner
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
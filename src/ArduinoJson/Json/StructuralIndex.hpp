@@ -0,0 +1,291 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint32_t, uint64_t
+#include <string.h>  // memcpy, memset
+
+#if ARDUINOJSON_USE_SSE2
+#  include <emmintrin.h>
+#endif
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The characters of a 64-byte block that matter to the StructuralIndex.
+// Bit i of each mask stands for the i-th character of the block.
+struct CharMasks {
+  uint64_t quotes;       // "
+  uint64_t backslashes;  // \ (backslash)
+  uint64_t structurals;  // { } [ ] : ,
+  uint64_t unsupported;  // ' and /, that can start a string or a comment
+  uint64_t nulls;        // \0, that ends the input for deserializeJson()
+};
+
+// Reference implementation, one character at a time
+inline void classifyCharsScalar(const char* p, CharMasks& masks) {
+  masks = CharMasks();
+  for (uint8_t i = 0; i < 64; i++) {
+    uint64_t bit = uint64_t(1) << i;
+    switch (p[i]) {
+      case '\"':
+        masks.quotes |= bit;
+        break;
+      case '\\':
+        masks.backslashes |= bit;
+        break;
+      case '{':
+      case '}':
+      case '[':
+      case ']':
+      case ':':
+      case ',':
+        masks.structurals |= bit;
+        break;
+      case '\'':
+      case '/':
+        masks.unsupported |= bit;
+        break;
+      case '\0':
+        masks.nulls |= bit;
+        break;
+    }
+  }
+}
+
+// Tests 8 characters at a time (SWAR).
+// Assumes a little-endian CPU: the first character is in the lowest byte.
+namespace Swar64 {
+const uint64_t lowBits = 0x0101010101010101;
+const uint64_t low7Bits = 0x7F7F7F7F7F7F7F7F;
+
+// Sets the high bit of the bytes that are equal to c, and only these
+inline uint64_t matchByte(uint64_t word, char c) {
+  uint64_t x = word ^ (lowBits * uint8_t(c));
+  return ~(((x & low7Bits) + low7Bits) | x | low7Bits);
+}
+
+// Packs the high bit of each byte in the 8 bits of the result
+inline uint64_t gatherHighBits(uint64_t word) {
+  return ((word >> 7) * 0x0102040810204080) >> 56;
+}
+}  // namespace Swar64
+
+inline void classifyCharsSwar(const char* p, CharMasks& masks) {
+  using namespace Swar64;
+  masks = CharMasks();
+  for (uint8_t i = 0; i < 64; i += 8) {
+    uint64_t word;
+    memcpy(&word, p + i, sizeof(word));
+
+    // '[' and ']' become '{' and '}'
+    uint64_t folded = word | (lowBits * 0x20);
+
+    masks.quotes |= gatherHighBits(matchByte(word, '\"')) << i;
+    masks.backslashes |= gatherHighBits(matchByte(word, '\\')) << i;
+    masks.structurals |=
+        gatherHighBits(matchByte(folded, '{') | matchByte(folded, '}') |
+                       matchByte(word, ':') | matchByte(word, ','))
+        << i;
+    masks.unsupported |=
+        gatherHighBits(matchByte(word, '\'') | matchByte(word, '/')) << i;
+    masks.nulls |= gatherHighBits(matchByte(word, '\0')) << i;
+  }
+}
+
+#if ARDUINOJSON_USE_SSE2
+// Tests 16 characters at a time
+inline void classifyCharsSse2(const char* p, CharMasks& masks) {
+  masks = CharMasks();
+  for (uint8_t i = 0; i < 64; i += 16) {
+    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+
+    // '[' and ']' become '{' and '}'
+    __m128i folded = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+
+    __m128i quotes = _mm_cmpeq_epi8(chars, _mm_set1_epi8('\"'));
+    __m128i backslashes = _mm_cmpeq_epi8(chars, _mm_set1_epi8('\\'));
+    __m128i structurals =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, _mm_set1_epi8('{')),
+                                  _mm_cmpeq_epi8(folded, _mm_set1_epi8('}'))),
+                     _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(':')),
+                                  _mm_cmpeq_epi8(chars, _mm_set1_epi8(','))));
+    __m128i unsupported =
+        _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\'')),
+                     _mm_cmpeq_epi8(chars, _mm_set1_epi8('/')));
+    __m128i nulls = _mm_cmpeq_epi8(chars, _mm_setzero_si128());
+
+    masks.quotes |= uint64_t(_mm_movemask_epi8(quotes)) << i;
+    masks.backslashes |= uint64_t(_mm_movemask_epi8(backslashes)) << i;
+    masks.structurals |= uint64_t(_mm_movemask_epi8(structurals)) << i;
+    masks.unsupported |= uint64_t(_mm_movemask_epi8(unsupported)) << i;
+    masks.nulls |= uint64_t(_mm_movemask_epi8(nulls)) << i;
+  }
+}
+#endif
+
+inline void classifyChars(const char* p, CharMasks& masks) {
+#if ARDUINOJSON_USE_SSE2
+  classifyCharsSse2(p, masks);
+#elif ARDUINOJSON_SIZEOF_POINTER >= 4 && \
+    !(defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+  classifyCharsSwar(p, masks);
+#else
+  classifyCharsScalar(p, masks);
+#endif
+}
+
+// Returns the characters that follow an unescaped backslash.
+// `carry` is 1 if the previous block ended with an unescaped backslash; it's
+// updated for the next block.
+inline uint64_t findEscapedChars(uint64_t backslashes, uint64_t& carry) {
+  uint64_t escaped = carry;
+  uint64_t pending = backslashes & ~carry;
+  carry = 0;
+  while (pending) {  // backslashes are rare, so this loop is short
+    uint64_t backslash = pending & (0 - pending);
+    uint64_t next = backslash << 1;
+    if (!next)
+      carry = 1;
+    escaped |= next;
+    pending &= ~(backslash | next);
+  }
+  return escaped;
+}
+
+// Sets each bit to the XOR of itself and all the lower bits, so that the bits
+// between an opening quote and the closing quote are set
+inline uint64_t prefixXor(uint64_t x) {
+  x ^= x << 1;
+  x ^= x << 2;
+  x ^= x << 4;
+  x ^= x << 8;
+  x ^= x << 16;
+  x ^= x << 32;
+  return x;
+}
+
+inline uint8_t countTrailingZeros(uint64_t x) {
+#if defined(__GNUC__)
+  return uint8_t(__builtin_ctzll(x));
+#else
+  static const uint8_t table[64] = {
+      0,  1,  48, 2,  57, 49, 28, 3,  61, 58, 50, 42, 38, 29, 17, 4,
+      62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+      63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+      46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9,  13, 8,  7,  6,
+  };
+  return table[((x & (0 - x)) * 0x03F79D71B4CB0A89) >> 58];
+#endif
+}
+
+// Stage 1 of deserializeJsonIndexed(): the positions of the structural
+// characters of a contiguous input, found 64 bytes at a time.
+// These are the brackets, braces, colons, and commas outside of the strings,
+// and the quotes around the strings. A last position, equal to the size of the
+// input, serves as a sentinel.
+class StructuralIndex {
+ public:
+  StructuralIndex(Allocator* allocator)
+      : allocator_(allocator), positions_(nullptr), size_(0), capacity_(0) {}
+
+  ~StructuralIndex() {
+    if (positions_)
+      allocator_->deallocate(positions_);
+  }
+
+  StructuralIndex(const StructuralIndex&) = delete;
+  StructuralIndex& operator=(const StructuralIndex&) = delete;
+
+  // Returns false if the input contains single quotes, slashes, null
+  // characters, or an unterminated string, or if the allocation fails
+  bool build(const char* input, size_t inputSize) {
+    size_ = 0;
+    if (inputSize >= 0xFFFFFFFF)
+      return false;
+    if (!reserve(inputSize / 4 + 65))  // a typical density
+      return false;
+
+    uint64_t escapeCarry = 0;
+    uint64_t stringCarry = 0;  // all ones if the last block ends in a string
+
+    for (size_t offset = 0; offset < inputSize; offset += 64) {
+      CharMasks masks;
+      if (inputSize - offset >= 64) {
+        classifyChars(input + offset, masks);
+      } else {
+        char block[64];
+        memset(block, ' ', sizeof(block));
+        memcpy(block, input + offset, inputSize - offset);
+        classifyChars(block, masks);
+      }
+
+      uint64_t escaped = findEscapedChars(masks.backslashes, escapeCarry);
+      uint64_t quotes = masks.quotes & ~escaped;
+      uint64_t inString = prefixXor(quotes) ^ stringCarry;
+      stringCarry = 0 - (inString >> 63);
+
+      if ((masks.unsupported & ~inString) | masks.nulls)
+        return false;
+
+      if (!reserve(size_ + 64))
+        return false;
+      append((masks.structurals & ~inString) | quotes, uint32_t(offset));
+    }
+
+    if (stringCarry)
+      return false;
+
+    if (!reserve(size_ + 1))
+      return false;
+    positions_[size_++] = uint32_t(inputSize);
+    return true;
+  }
+
+  // Returns the number of positions, sentinel included
+  size_t size() const {
+    return size_;
+  }
+
+  uint32_t operator[](size_t i) const {
+    ARDUINOJSON_ASSERT(i < size_);
+    return positions_[i];
+  }
+
+ private:
+  bool reserve(size_t capacity) {
+    if (capacity <= capacity_)
+      return true;
+    if (capacity < capacity_ * 2)
+      capacity = capacity_ * 2;
+    void* positions;
+    if (positions_)
+      positions = allocator_->reallocate(positions_, capacity * 4);
+    else
+      positions = allocator_->allocate(capacity * 4);
+    if (!positions)
+      return false;
+    positions_ = static_cast<uint32_t*>(positions);
+    capacity_ = capacity;
+    return true;
+  }
+
+  void append(uint64_t mask, uint32_t offset) {
+    while (mask) {
+      positions_[size_++] = offset + countTrailingZeros(mask);
+      mask &= mask - 1;
+    }
+  }
+
+  Allocator* allocator_;
+  uint32_t* positions_;
+  size_t size_;
+  size_t capacity_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -16,30 +16,28 @@ inline void encodeCodepoint(uint32_t codepoint32, TStringBuilder& str) {
   if (codepoint32 < 0x80) {
     str.append(char(codepoint32));
   } else {
-    // a buffer to store the string in reverse
-    char buf[5];
-    char* p = buf;
+    // a buffer that we fill from the end
+    char buf[4];
+    char* end = buf + sizeof(buf);
+    char* p = end;
 
-    *(p++) = 0;
-    *(p++) = char((codepoint32 | 0x80) & 0xBF);
+    *(--p) = char((codepoint32 | 0x80) & 0xBF);
     uint16_t codepoint16 = uint16_t(codepoint32 >> 6);
     if (codepoint16 < 0x20) {  // 0x800
-      *(p++) = char(codepoint16 | 0xC0);
+      *(--p) = char(codepoint16 | 0xC0);
     } else {
-      *(p++) = char((codepoint16 | 0x80) & 0xBF);
+      *(--p) = char((codepoint16 | 0x80) & 0xBF);
       codepoint16 = uint16_t(codepoint16 >> 6);
       if (codepoint16 < 0x10) {  // 0x10000
-        *(p++) = char(codepoint16 | 0xE0);
+        *(--p) = char(codepoint16 | 0xE0);
       } else {
-        *(p++) = char((codepoint16 | 0x80) & 0xBF);
+        *(--p) = char((codepoint16 | 0x80) & 0xBF);
         codepoint16 = uint16_t(codepoint16 >> 6);
-        *(p++) = char(codepoint16 | 0xF0);
+        *(--p) = char(codepoint16 | 0xF0);
       }
     }
 
-    while (*(--p)) {
-      str.append(*p);
-    }
+    str.append(p, size_t(end - p));
   }
 }
 }  // namespace Utf8
@@ -0,0 +1,115 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+#include <ArduinoJson/Json/StructuralIndex.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The input of the second stage of deserializeJsonIndexed(): a contiguous
+// input and the positions of its structural characters
+struct IndexedInput {
+  const char* begin;
+  const char* end;
+  const StructuralIndex* index;
+};
+
+// The latch that JsonDeserializer uses for an IndexedInput.
+// It works like a PointerLatch, except that it finds the end of a string in
+// the StructuralIndex instead of looking at each character.
+template <>
+class Latch<IndexedInput> : public PointerLatch {
+ public:
+  using reader_type = Latch<IndexedInput>;
+
+  Latch(IndexedInput input)
+      : PointerLatch(input.begin, input.end),
+        input_(input.begin),
+        index_(*input.index),
+        next_(0) {}
+
+  int last() const {
+    return current();
+  }
+
+  Latch* reader() {
+    return this;
+  }
+
+  // Returns the closing quote of the string that contains `p`, or the first
+  // backslash before it
+  const char* skipPlainChars(const char* p, char stopChar) {
+    auto offset = uint32_t(p - input_);
+    while (index_[next_] < offset)  // the last position is the end
+      next_++;
+    auto quote = input_ + index_[next_];
+    if (quote == end() || *quote != stopChar)
+      return Scanner::skipPlainChars(p, end(), stopChar);
+    auto backslash = memchr(p, '\\', size_t(quote - p));
+    return backslash ? static_cast<const char*>(backslash) : quote;
+  }
+
+ private:
+  const char* input_;
+  const StructuralIndex& index_;
+  size_t next_;
+};
+
+inline const char* scanPlainChars(Latch<IndexedInput>& latch, const char* p,
+                                  char stopChar) {
+  return latch.skipPlainChars(p, stopChar);
+}
+
+template <typename TOptions>
+DeserializationError parseJsonIndexed(JsonDocument& doc, const char* input,
+                                      size_t inputSize, TOptions options) {
+  auto resources = VariantAttorney::getResourceManager(doc);
+
+  StructuralIndex index(resources->allocator());
+  if (!index.build(input, inputSize))
+    return doDeserialize<JsonDeserializer>(doc, makeReader(input, inputSize),
+                                           options);
+
+  IndexedInput indexedInput = {input, input + inputSize, &index};
+  return doDeserialize<JsonDeserializer>(doc, indexedInput, options);
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Parses a JSON input in two stages, and puts the result in a JsonDocument.
+// The first stage finds the structural characters 64 bytes at a time (with
+// SSE2 if ARDUINOJSON_USE_SSE2 is set), and stores their positions in a
+// temporary index that takes 4 bytes per character; the second stage runs the
+// same parser as deserializeJson(), but finds the end of the strings in this
+// index.
+// The result is the same as deserializeJson(). The function falls back to
+// deserializeJson() if the input contains comments, single quotes, or null
+// characters, or if the index doesn't fit in memory.
+template <typename Size, typename... Args,
+          typename = detail::enable_if_t<detail::is_integral<Size>::value>>
+DeserializationError deserializeJsonIndexed(JsonDocument& doc,
+                                            const char* input, Size inputSize,
+                                            Args... args) {
+  using namespace detail;
+  return parseJsonIndexed(doc, input, size_t(inputSize),
+                          makeDeserializationOptions(args...));
+}
+
+// Parses a JSON input in two stages, and puts the result in a JsonDocument.
+// See above.
+template <typename... Args,
+          typename = detail::enable_if_t<!detail::is_integral<
+              typename detail::first_or_void<Args...>::type>::value>>
+DeserializationError deserializeJsonIndexed(JsonDocument& doc,
+                                            const char* input, Args... args) {
+  using namespace detail;
+  return parseJsonIndexed(doc, input, input ? strlen(input) : 0,
+                          makeDeserializationOptions(args...));
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,188 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+
+#if ARDUINOJSON_ENABLE_STD_THREAD
+
+#  include <system_error>
+#  include <thread>
+#  include <vector>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Splits the elements of the array at the root into chunks of similar sizes.
+// Fills `bounds` with the beginning of each chunk, followed by the end of the
+// array; each chunk ends one character before the next one begins (on the
+// comma or on the closing bracket).
+// Returns false if the input is not an array that can be split, for example
+// because it contains comments, or has a single element.
+inline bool splitJsonArray(const char* p, const char* end, size_t chunkCount,
+                           std::vector<const char*>& bounds) {
+  p = Scanner::skipSpaces(p, end);
+  if (p == end || *p != '[')
+    return false;
+  p++;
+
+  size_t chunkSize = size_t(end - p) / chunkCount + 1;
+  const char* nextBound = p + chunkSize;
+  bounds.push_back(p);
+
+  size_t depth = 0;
+  while (p != end) {
+    char c = *p++;
+    switch (c) {
+      case '\"':
+      case '\'':
+        for (;;) {
+          p = Scanner::skipPlainChars(p, end, c);
+          if (p == end || *p == '\0')
+            return false;
+          if (*p == c)
+            break;
+          if (*p == '\\' && ++p == end)
+            return false;
+          p++;
+        }
+        p++;
+        break;
+
+      case '[':
+      case '{':
+        depth++;
+        break;
+
+      case ']':
+      case '}':
+        if (depth == 0) {
+          if (c != ']')
+            return false;
+          bounds.push_back(p);
+          return bounds.size() > 2;
+        }
+        depth--;
+        break;
+
+      case ',':
+        if (depth == 0 && p > nextBound) {
+          bounds.push_back(p);
+          nextBound = p + chunkSize;
+        }
+        break;
+
+      case '/':
+      case '\0':
+        return false;
+    }
+  }
+
+  return false;  // incomplete input
+}
+
+template <typename TOptions>
+DeserializationError parseJsonParallel(JsonDocument& doc, const char* input,
+                                       size_t inputSize, size_t threadCount,
+                                       TOptions options) {
+  using TReader = BoundedReader<const char*>;
+
+  // The pools of the chunks can only be merged if they all have the same
+  // capacity, see MemoryPoolList::append()
+  auto resources = VariantAttorney::getResourceManager(doc);
+  std::vector<const char*> bounds;
+  if (threadCount < 2 || !options.filter.allowArray() ||
+      options.nestingLimit.reached() ||
+      resources->maxPoolCapacity() != ARDUINOJSON_POOL_CAPACITY ||
+      !splitJsonArray(input, input + inputSize, threadCount, bounds))
+    return doDeserialize<JsonDeserializer>(
+        doc, makeReader(input, inputSize), options);
+
+  // Each thread parses a chunk in its own document, so they don't share any
+  // memory pool
+  size_t chunkCount = bounds.size() - 1;
+  std::vector<JsonDocument> chunks;
+  chunks.reserve(chunkCount);
+  for (size_t i = 0; i < chunkCount; i++) {
+    chunks.emplace_back(doc.allocator());
+    chunks[i].setMaxPoolCapacity(ARDUINOJSON_POOL_CAPACITY);
+  }
+  std::vector<DeserializationError> errors(chunkCount);
+
+  auto parseChunk = [&](size_t i) {
+    auto& chunk = chunks[i];
+    auto begin = bounds[i];
+    auto end = bounds[i + 1] - 1;
+    errors[i] = JsonDeserializer<TReader>(
+                    VariantAttorney::getResourceManager(chunk),
+                    makeReader(begin, size_t(end - begin)))
+                    .parseElements(*VariantAttorney::getOrCreateData(chunk),
+                                   options.filter, options.nestingLimit);
+  };
+
+  // If the system can't start a thread, the current one parses the
+  // remaining chunks
+  std::vector<std::thread> threads;
+  threads.reserve(chunkCount - 1);
+  try {
+    for (size_t i = 1; i < chunkCount; i++)
+      threads.emplace_back(parseChunk, i);
+  } catch (const std::system_error&) {
+  }
+  for (size_t i = threads.size() + 1; i < chunkCount; i++)
+    parseChunk(i);
+  parseChunk(0);
+  for (auto& thread : threads)
+    thread.join();
+
+  // Parse serially to report the same error, with the same partial result
+  for (auto& error : errors) {
+    if (error)
+      return doDeserialize<JsonDeserializer>(
+          doc, makeReader(input, inputSize), options);
+  }
+
+  // Move the slots and the strings of the chunks to the document, and link
+  // the elements in order
+  doc.clear();  // the pools of the chunks replace the pools of the document
+  auto& array = VariantAttorney::getOrCreateData(doc)->toArray();
+  for (auto& chunk : chunks) {
+    SlotId offset;
+    if (!resources->merge(*VariantAttorney::getResourceManager(chunk), offset))
+      return doDeserialize<JsonDeserializer>(
+          doc, makeReader(input, inputSize), options);
+    auto elements = VariantAttorney::getOrCreateData(chunk)->asArray();
+    elements->rebase(offset, resources);
+    array.splice(*elements, resources);
+  }
+  array.buildIndex(resources);
+  shrinkJsonDocument(doc);
+  return DeserializationError::Ok;
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Parses a large JSON array with several threads, and puts the result in a
+// JsonDocument.
+// Each thread parses a part of the elements in a temporary document that uses
+// the allocator of `doc`; then, `doc` takes the memory pools and the strings of
+// these documents, and links the elements, without copying them.
+// The result is the same as deserializeJson(). The input falls back to
+// deserializeJson() if it's not an array, if it contains comments, or if the
+// memory pools can grow (see JsonDocument::setMaxPoolCapacity()).
+template <typename... Args>
+DeserializationError deserializeJsonParallel(JsonDocument& doc,
+                                             const char* input,
+                                             size_t inputSize,
+                                             size_t threadCount, Args... args) {
+  using namespace detail;
+  return parseJsonParallel(doc, input, inputSize, threadCount,
+                           makeDeserializationOptions(args...));
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+#endif
@@ -0,0 +1,192 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/MemoryPool.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A table of slot ids attached to a large collection to speed up lookups.
+// The collection decides how the slots are organized.
+struct CollectionIndex {
+  SlotId* slots;
+  size_t capacity;
+  size_t count;
+
+  bool resize(size_t newCapacity, Allocator* allocator) {
+    auto newSlots = reinterpret_cast<SlotId*>(
+        allocator->reallocate(slots, newCapacity * sizeof(SlotId)));
+    if (!newSlots)
+      return false;
+    slots = newSlots;
+    capacity = newCapacity;
+    return true;
+  }
+
+  void release(Allocator* allocator) {
+    if (slots)
+      allocator->deallocate(slots);
+    slots = nullptr;
+    capacity = 0;
+    count = 0;
+  }
+};
+
+// Associates a CollectionIndex to the id of the first slot of a collection.
+// It's an open-addressing hash table with linear probing; its capacity is a
+// power of two, and it's never more than half full.
+class CollectionIndexMap {
+  struct Entry {
+    SlotId owner;
+    CollectionIndex index;
+  };
+
+ public:
+  CollectionIndexMap() = default;
+  CollectionIndexMap(const CollectionIndexMap&) = delete;
+  CollectionIndexMap& operator=(const CollectionIndexMap&) = delete;
+
+  ~CollectionIndexMap() {
+    ARDUINOJSON_ASSERT(entries_ == nullptr);
+  }
+
+  friend void swap(CollectionIndexMap& a, CollectionIndexMap& b) {
+    swap_(a.entries_, b.entries_);
+    swap_(a.capacity_, b.capacity_);
+    swap_(a.count_, b.count_);
+  }
+
+  // Returns the index of the collection, or null if it's not indexed.
+  // The pointer remains valid until the next call to create()
+  CollectionIndex* find(SlotId owner) const {
+    if (!count_)
+      return nullptr;
+    for (auto i = firstSlot(owner); entries_[i].owner != NULL_SLOT;
+         i = nextSlot(i)) {
+      if (entries_[i].owner == owner)
+        return &entries_[i].index;
+    }
+    return nullptr;
+  }
+
+  // Adds an empty index for the collection.
+  // Returns null if allocation fails.
+  CollectionIndex* create(SlotId owner, Allocator* allocator) {
+    ARDUINOJSON_ASSERT(owner != NULL_SLOT);
+    ARDUINOJSON_ASSERT(find(owner) == nullptr);
+    if ((count_ + 1) * 2 > capacity_ && !grow(allocator))
+      return nullptr;
+    return insert(owner, CollectionIndex{nullptr, 0, 0});
+  }
+
+  void destroy(SlotId owner, Allocator* allocator) {
+    auto index = find(owner);
+    if (!index)
+      return;
+    index->release(allocator);
+    remove(owner);
+  }
+
+  // Attaches the index to a different slot, when the first slot of the
+  // collection is removed
+  void move(SlotId from, SlotId to) {
+    ARDUINOJSON_ASSERT(to != NULL_SLOT);
+    auto index = find(from);
+    if (!index)
+      return;
+    auto copy = *index;
+    remove(from);
+    insert(to, copy);  // can't fail since we just removed an entry
+  }
+
+  static const size_t initialCapacity = 8;
+
+  // Returns the size (in bytes) of the table
+  static size_t sizeofEntries(size_t capacity = initialCapacity) {
+    return capacity * sizeof(Entry);
+  }
+
+  void clear(Allocator* allocator) {
+    for (size_t i = 0; i < capacity_; i++) {
+      if (entries_[i].owner != NULL_SLOT)
+        entries_[i].index.release(allocator);
+    }
+    if (entries_)
+      allocator->deallocate(entries_);
+    entries_ = nullptr;
+    capacity_ = 0;
+    count_ = 0;
+  }
+
+ private:
+  size_t firstSlot(SlotId owner) const {
+    return owner & (capacity_ - 1);
+  }
+
+  size_t nextSlot(size_t i) const {
+    return (i + 1) & (capacity_ - 1);
+  }
+
+  CollectionIndex* insert(SlotId owner, CollectionIndex index) {
+    auto i = firstSlot(owner);
+    while (entries_[i].owner != NULL_SLOT)
+      i = nextSlot(i);
+    entries_[i].owner = owner;
+    entries_[i].index = index;
+    count_++;
+    return &entries_[i].index;
+  }
+
+  // Backward-shift deletion, see StringPool::removeFromIndex()
+  void remove(SlotId owner) {
+    auto hole = firstSlot(owner);
+    while (entries_[hole].owner != owner)
+      hole = nextSlot(hole);
+    for (auto i = nextSlot(hole); entries_[i].owner != NULL_SLOT;
+         i = nextSlot(i)) {
+      auto home = firstSlot(entries_[i].owner);
+      bool canMove =
+          hole < i ? (home <= hole || home > i) : (home <= hole && home > i);
+      if (canMove) {
+        entries_[hole] = entries_[i];
+        hole = i;
+      }
+    }
+    entries_[hole].owner = NULL_SLOT;
+    count_--;
+  }
+
+  bool grow(Allocator* allocator) {
+    auto newCapacity = capacity_ ? capacity_ * 2 : initialCapacity;
+    auto newEntries = reinterpret_cast<Entry*>(
+        allocator->allocate(sizeofEntries(newCapacity)));
+    if (!newEntries)
+      return false;
+    for (size_t i = 0; i < newCapacity; i++)
+      newEntries[i].owner = NULL_SLOT;
+
+    auto oldEntries = entries_;
+    auto oldCapacity = capacity_;
+    entries_ = newEntries;
+    capacity_ = newCapacity;
+    count_ = 0;
+    for (size_t i = 0; i < oldCapacity; i++) {
+      if (oldEntries[i].owner != NULL_SLOT)
+        insert(oldEntries[i].owner, oldEntries[i].index);
+    }
+    if (oldEntries)
+      allocator->deallocate(oldEntries);
+    return true;
+  }
+
+  Entry* entries_ = nullptr;
+  size_t capacity_ = 0;
+  size_t count_ = 0;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,69 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Forwards the requests to the user's allocator and counts them
+class CountingAllocator final : public Allocator {
+ public:
+  CountingAllocator(Allocator* upstream) : upstream_(upstream) {}
+
+  CountingAllocator(const CountingAllocator&) = delete;
+  CountingAllocator& operator=(const CountingAllocator&) = delete;
+
+  friend void swap(CountingAllocator& a, CountingAllocator& b) {
+    swap_(a.upstream_, b.upstream_);
+    swap_(a.calls_, b.calls_);
+    swap_(a.bytes_, b.bytes_);
+  }
+
+  void* allocate(size_t size) override {
+    calls_++;
+    bytes_ += size;
+    return upstream_->allocate(size);
+  }
+
+  void deallocate(void* ptr) override {
+    calls_++;
+    upstream_->deallocate(ptr);
+  }
+
+  void* reallocate(void* ptr, size_t newSize) override {
+    calls_++;
+    bytes_ += newSize;
+    return upstream_->reallocate(ptr, newSize);
+  }
+
+  // Adds the counters of another instance
+  void addCounters(const CountingAllocator& src) {
+    calls_ += src.calls_;
+    bytes_ += src.bytes_;
+  }
+
+  Allocator* upstream() const {
+    return upstream_;
+  }
+
+  // Number of calls to allocate(), deallocate(), and reallocate()
+  size_t calls() const {
+    return calls_;
+  }
+
+  // Sum of the sizes passed to allocate() and reallocate()
+  size_t bytes() const {
+    return bytes_;
+  }
+
+ private:
+  Allocator* upstream_;
+  size_t calls_ = 0;
+  size_t bytes_ = 0;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -81,6 +81,8 @@ class MemoryPool {
   }
 
   void shrinkToFit(Allocator* allocator) {
+    if (usage_ == capacity_)
+      return;
     auto newSlots = reinterpret_cast<T*>(
         allocator->reallocate(slots_, slotsToBytes(usage_)));
     if (newSlots) {
@@ -93,6 +95,10 @@ class MemoryPool {
     return usage_;
   }
 
+  SlotCount capacity() const {
+    return capacity_;
+  }
+
   static SlotCount bytesToSlots(size_t n) {
     return static_cast<SlotCount>(n / sizeof(T));
   }
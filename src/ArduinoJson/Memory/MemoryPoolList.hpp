@@ -14,6 +14,15 @@ ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 using PoolCount = SlotId;
 
+// Returns how many times a pool of ARDUINOJSON_POOL_CAPACITY slots can double
+// without exceeding maxCapacity
+constexpr uint8_t poolGrowthSteps(size_t maxCapacity,
+                                  size_t capacity = ARDUINOJSON_POOL_CAPACITY) {
+  return capacity * 2 <= maxCapacity && capacity <= NULL_SLOT / 4
+             ? uint8_t(1 + poolGrowthSteps(maxCapacity, capacity * 2))
+             : uint8_t(0);
+}
+
 template <typename T>
 class MemoryPoolList {
   struct FreeSlot {
@@ -29,6 +38,7 @@ class MemoryPoolList {
 
   ~MemoryPoolList() {
     ARDUINOJSON_ASSERT(count_ == 0);
+    ARDUINOJSON_ASSERT(spareCount_ == 0);
   }
 
   friend void swap(MemoryPoolList& a, MemoryPoolList& b) {
@@ -42,13 +52,13 @@ class MemoryPoolList {
         swap_(a.preallocatedPools_[i], b.preallocatedPools_[i]);
     } else if (bUsedPreallocated) {
       // only b => copy b's preallocated pools and give him a's pointer
-      for (PoolCount i = 0; i < b.count_; i++)
+      for (PoolCount i = 0; i < b.count_ + b.spareCount_; i++)
         a.preallocatedPools_[i] = b.preallocatedPools_[i];
       b.pools_ = a.pools_;
       a.pools_ = a.preallocatedPools_;
     } else if (aUsedPreallocated) {
       // only a => copy a's preallocated pools and give him b's pointer
-      for (PoolCount i = 0; i < a.count_; i++)
+      for (PoolCount i = 0; i < a.count_ + a.spareCount_; i++)
         b.preallocatedPools_[i] = a.preallocatedPools_[i];
       a.pools_ = b.pools_;
       b.pools_ = b.preallocatedPools_;
@@ -58,12 +68,19 @@ class MemoryPoolList {
     }
 
     swap_(a.count_, b.count_);
+    swap_(a.spareCount_, b.spareCount_);
     swap_(a.capacity_, b.capacity_);
     swap_(a.freeList_, b.freeList_);
+    swap_(a.growthSteps_, b.growthSteps_);
+#if ARDUINOJSON_ENABLE_STATS
+    swap_(a.usedSlots_, b.usedSlots_);
+    swap_(a.totalSlots_, b.totalSlots_);
+#endif
   }
 
   MemoryPoolList& operator=(MemoryPoolList&& src) {
     ARDUINOJSON_ASSERT(count_ == 0);
+    ARDUINOJSON_ASSERT(spareCount_ == 0);
     if (src.pools_ == src.preallocatedPools_) {
       memcpy(preallocatedPools_, src.preallocatedPools_,
              sizeof(preallocatedPools_));
@@ -73,9 +90,18 @@ class MemoryPoolList {
       src.pools_ = nullptr;
     }
     count_ = src.count_;
+    spareCount_ = src.spareCount_;
     capacity_ = src.capacity_;
+    growthSteps_ = src.growthSteps_;
     src.count_ = 0;
+    src.spareCount_ = 0;
     src.capacity_ = 0;
+#if ARDUINOJSON_ENABLE_STATS
+    usedSlots_ = src.usedSlots_;
+    totalSlots_ = src.totalSlots_;
+    src.usedSlots_ = 0;
+    src.totalSlots_ = 0;
+#endif
     return *this;
   }
 
@@ -103,22 +129,66 @@ class MemoryPoolList {
   void freeSlot(Slot<T> slot) {
     reinterpret_cast<FreeSlot*>(slot.ptr())->next = freeList_;
     freeList_ = slot.id();
+#if ARDUINOJSON_ENABLE_STATS
+    usedSlots_--;
+#endif
+  }
+
+#if ARDUINOJSON_ENABLE_STATS
+  // Number of slots in use, i.e., allocated and not freed
+  SlotCount usedSlots() const {
+    return usedSlots_;
+  }
+
+  // Number of slots that can be allocated without calling the allocator
+  size_t freeSlots() const {
+    return totalSlots_ - usedSlots_;
+  }
+
+  PoolCount poolCount() const {
+    return PoolCount(count_ + spareCount_);
   }
+#endif
 
   T* getSlot(SlotId id) const {
     if (id == NULL_SLOT)
       return nullptr;
-    auto poolIndex = SlotId(id / ARDUINOJSON_POOL_CAPACITY);
-    auto indexInPool = SlotId(id % ARDUINOJSON_POOL_CAPACITY);
+    // n counts the slots in units of the first pool, so pool i starts at
+    // n = 2^i until the pools stop growing
+    auto n = size_t(id / ARDUINOJSON_POOL_CAPACITY) + 1;
+    PoolCount poolIndex;
+    if (n >> growthSteps_)  // one of the pools of maximum capacity
+      poolIndex = PoolCount(growthSteps_ + (n >> growthSteps_) - 1);
+    else
+      poolIndex = log2(n);
     ARDUINOJSON_ASSERT(poolIndex < count_);
-    return pools_[poolIndex].getSlot(indexInPool);
+    return pools_[poolIndex].getSlot(SlotId(id - firstSlotOfPool(poolIndex)));
+  }
+
+  // Makes each pool twice as big as the previous one, starting from
+  // ARDUINOJSON_POOL_CAPACITY, until they reach maxCapacity slots.
+  // Returns false if the pools are already created.
+  bool setMaxPoolCapacity(size_t maxCapacity) {
+    if (count_ + spareCount_ > 0)
+      return false;
+    growthSteps_ = poolGrowthSteps(maxCapacity);
+    return true;
+  }
+
+  size_t maxPoolCapacity() const {
+    return size_t(ARDUINOJSON_POOL_CAPACITY) << growthSteps_;
   }
 
   void clear(Allocator* allocator) {
-    for (PoolCount i = 0; i < count_; i++)
+    for (PoolCount i = 0; i < count_ + spareCount_; i++)
       pools_[i].destroy(allocator);
     count_ = 0;
+    spareCount_ = 0;
     freeList_ = NULL_SLOT;
+#if ARDUINOJSON_ENABLE_STATS
+    usedSlots_ = 0;
+    totalSlots_ = 0;
+#endif
     if (pools_ != preallocatedPools_) {
       allocator->deallocate(pools_);
       pools_ = preallocatedPools_;
@@ -126,6 +196,53 @@ class MemoryPoolList {
     }
   }
 
+  // Creates spare pools until n slots can be allocated without calling the
+  // allocator
+  bool reserve(size_t n, Allocator* allocator) {
+    size_t available = 0;
+    if (count_ > 0)
+      available += size_t(pools_[count_ - 1].capacity() -
+                          pools_[count_ - 1].usage());
+    for (PoolCount i = 0; i < spareCount_; i++)
+      available += pools_[count_ + i].capacity();
+    if (available >= n)
+      return true;
+
+    size_t totalPools = count_ + spareCount_;
+    while (available < n) {
+      if (totalPools >= maxPools || !capacityOfPool(PoolCount(totalPools)))
+        return false;
+      available += capacityOfPool(PoolCount(totalPools++));
+    }
+    if (totalPools > capacity_ &&
+        !resizePoolArray(PoolCount(totalPools), allocator))
+      return false;
+
+    while (count_ + spareCount_ < totalPools) {
+      auto index = PoolCount(count_ + spareCount_);
+      pools_[index].create(capacityOfPool(index), allocator);
+      if (!pools_[index].capacity())
+        return false;
+#if ARDUINOJSON_ENABLE_STATS
+      totalSlots_ += pools_[index].capacity();
+#endif
+      spareCount_++;
+    }
+    return true;
+  }
+
+  // Releases all the slots but keeps the pools for future allocations
+  void reset() {
+    for (PoolCount i = 0; i < count_; i++)
+      pools_[i].clear();
+    spareCount_ = PoolCount(spareCount_ + count_);
+    count_ = 0;
+    freeList_ = NULL_SLOT;
+#if ARDUINOJSON_ENABLE_STATS
+    usedSlots_ = 0;
+#endif
+  }
+
   SlotCount usage() const {
     SlotCount total = 0;
     for (PoolCount i = 0; i < count_; i++)
@@ -138,8 +255,8 @@ class MemoryPoolList {
   }
 
   void shrinkToFit(Allocator* allocator) {
-    if (count_ > 0)
-      pools_[count_ - 1].shrinkToFit(allocator);
+    releaseSparePools(allocator);
+    shrinkLastPool(allocator);
     if (pools_ != preallocatedPools_ && count_ != capacity_) {
       pools_ = static_cast<Pool*>(
           allocator->reallocate(pools_, count_ * sizeof(Pool)));
@@ -148,12 +265,90 @@ class MemoryPoolList {
     }
   }
 
+  // Moves the pools of src after the pools of this list; the slot ids of src
+  // must then be shifted by `offset`.
+  // Only works when all the pools have the same capacity, i.e., when neither
+  // list can grow its pools.
+  // Returns false if the pools don't fit, or if allocation fails.
+  bool append(MemoryPoolList& src, SlotId& offset, Allocator* allocator) {
+    if (growthSteps_ || src.growthSteps_)
+      return false;
+    releaseSparePools(allocator);
+    src.releaseSparePools(allocator);
+    if (src.count_ == 0) {
+      offset = 0;
+      return true;
+    }
+
+    auto totalPools = size_t(count_) + src.count_;
+    if (totalPools > maxPools ||
+        capacityOfPool(PoolCount(totalPools - 1)) <
+            src.pools_[src.count_ - 1].capacity())
+      return false;
+
+    // our last pool won't receive new slots anymore
+    shrinkLastPool(allocator);
+    if (totalPools > capacity_ &&
+        !resizePoolArray(PoolCount(totalPools), allocator))
+      return false;
+
+    offset = SlotId(firstSlotOfPool(count_));
+    for (PoolCount i = 0; i < src.count_; i++)
+      pools_[count_ + i] = src.pools_[i];
+    count_ = PoolCount(totalPools);
+
+    if (src.freeList_ != NULL_SLOT) {
+      auto id = SlotId(src.freeList_ + offset);
+      for (;;) {
+        auto slot = reinterpret_cast<FreeSlot*>(getSlot(id));
+        if (slot->next == NULL_SLOT) {
+          slot->next = freeList_;
+          break;
+        }
+        slot->next = SlotId(slot->next + offset);
+        id = slot->next;
+      }
+      freeList_ = SlotId(src.freeList_ + offset);
+    }
+
+#if ARDUINOJSON_ENABLE_STATS
+    usedSlots_ = SlotCount(usedSlots_ + src.usedSlots_);
+    totalSlots_ += src.totalSlots_;
+    src.usedSlots_ = 0;
+    src.totalSlots_ = 0;
+#endif
+    src.count_ = 0;
+    src.freeList_ = NULL_SLOT;
+    if (src.pools_ != src.preallocatedPools_) {
+      allocator->deallocate(src.pools_);
+      src.pools_ = src.preallocatedPools_;
+      src.capacity_ = ARDUINOJSON_INITIAL_POOL_COUNT;
+    }
+    return true;
+  }
+
  private:
+  void shrinkLastPool(Allocator* allocator) {
+    if (count_ == 0)
+      return;
+    auto& lastPool = pools_[count_ - 1];
+#if ARDUINOJSON_ENABLE_STATS
+    totalSlots_ -= lastPool.capacity();
+#endif
+    lastPool.shrinkToFit(allocator);
+#if ARDUINOJSON_ENABLE_STATS
+    totalSlots_ += lastPool.capacity();
+#endif
+  }
+
   Slot<T> allocFromFreeList() {
     ARDUINOJSON_ASSERT(freeList_ != NULL_SLOT);
     auto id = freeList_;
     auto slot = getSlot(freeList_);
     freeList_ = reinterpret_cast<FreeSlot*>(slot)->next;
+#if ARDUINOJSON_ENABLE_STATS
+    usedSlots_++;
+#endif
     return {slot, id};
   }
 
@@ -163,26 +358,74 @@ class MemoryPoolList {
     auto slot = pools_[poolIndex].allocSlot();
     if (!slot)
       return {};
-    return {slot.ptr(),
-            SlotId(poolIndex * ARDUINOJSON_POOL_CAPACITY + slot.id())};
+#if ARDUINOJSON_ENABLE_STATS
+    usedSlots_++;
+#endif
+    return {slot.ptr(), SlotId(firstSlotOfPool(poolIndex) + slot.id())};
   }
 
   Pool* addPool(Allocator* allocator) {
+    if (spareCount_ > 0) {
+      spareCount_--;
+      return &pools_[count_++];
+    }
+    auto poolCapacity = capacityOfPool(count_);
+    if (!poolCapacity)
+      return nullptr;
     if (count_ == capacity_ && !increaseCapacity(allocator))
       return nullptr;
     auto pool = &pools_[count_++];
-    SlotCount poolCapacity = ARDUINOJSON_POOL_CAPACITY;
-    if (count_ == maxPools)  // last pool is smaller because of NULL_SLOT
-      poolCapacity--;
     pool->create(poolCapacity, allocator);
+#if ARDUINOJSON_ENABLE_STATS
+    totalSlots_ += pool->capacity();
+#endif
     return pool;
   }
 
+  static PoolCount log2(size_t n) {
+    PoolCount result = 0;
+    while (n >>= 1)
+      result++;
+    return result;
+  }
+
+  size_t firstSlotOfPool(PoolCount index) const {
+    size_t growing = index < growthSteps_ ? index : growthSteps_;
+    size_t full = index - growing;  // number of pools of maximum capacity
+    return ARDUINOJSON_POOL_CAPACITY *
+           ((size_t(1) << growing) - 1 + (full << growthSteps_));
+  }
+
+  // Returns 0 if the pool would overflow the SlotId
+  SlotCount capacityOfPool(PoolCount index) const {
+    size_t first = firstSlotOfPool(index);
+    if (first >= NULL_SLOT)
+      return 0;
+    auto capacity = size_t(ARDUINOJSON_POOL_CAPACITY)
+                    << (index < growthSteps_ ? index : growthSteps_);
+    if (capacity > NULL_SLOT - first)  // the last id is reserved for NULL_SLOT
+      capacity = NULL_SLOT - first;
+    return SlotCount(capacity);
+  }
+
+  void releaseSparePools(Allocator* allocator) {
+    for (PoolCount i = 0; i < spareCount_; i++) {
+#if ARDUINOJSON_ENABLE_STATS
+      totalSlots_ -= pools_[count_ + i].capacity();
+#endif
+      pools_[count_ + i].destroy(allocator);
+    }
+    spareCount_ = 0;
+  }
+
   bool increaseCapacity(Allocator* allocator) {
     if (capacity_ == maxPools)
       return false;
+    return resizePoolArray(PoolCount(capacity_ * 2), allocator);
+  }
+
+  bool resizePoolArray(PoolCount newCapacity, Allocator* allocator) {
     void* newPools;
-    auto newCapacity = PoolCount(capacity_ * 2);
 
     if (pools_ == preallocatedPools_) {
       newPools = allocator->allocate(newCapacity * sizeof(Pool));
@@ -203,8 +446,14 @@ class MemoryPoolList {
   Pool preallocatedPools_[ARDUINOJSON_INITIAL_POOL_COUNT];
   Pool* pools_ = preallocatedPools_;
   PoolCount count_ = 0;
+  PoolCount spareCount_ = 0;  // unused pools after count_, see reserve()
   PoolCount capacity_ = ARDUINOJSON_INITIAL_POOL_COUNT;
   SlotId freeList_ = NULL_SLOT;
+  uint8_t growthSteps_ = poolGrowthSteps(ARDUINOJSON_MAX_POOL_CAPACITY);
+#if ARDUINOJSON_ENABLE_STATS
+  SlotCount usedSlots_ = 0;
+  size_t totalSlots_ = 0;  // capacity of all the pools, including spares
+#endif
 
  public:
   static const PoolCount maxPools =
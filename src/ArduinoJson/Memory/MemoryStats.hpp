@@ -0,0 +1,30 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stddef.h>  // size_t
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Memory statistics of a JsonDocument, see JsonDocument::stats()
+struct MemoryStats {
+  size_t slotsUsed;    // slots that contain a value
+  size_t slotsFree;    // slots available in the memory pools
+  size_t poolCount;    // memory pools allocated
+  size_t stringCount;  // strings stored in the document
+  size_t stringBytes;  // memory used by these strings
+
+  // The following counters cover the whole life of the document
+  size_t dedupHits;       // strings that reused an existing copy
+  size_t allocatorCalls;  // calls to allocate(), deallocate(), reallocate()
+  size_t allocatedBytes;  // sum of the sizes requested to the allocator
+
+  // Highest memory usage (the size of the used slots plus stringBytes)
+  size_t peakUsage;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,149 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Alignment.hpp>
+#include <ArduinoJson/Memory/Allocator.hpp>
+
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// An allocator that carves blocks out of a user-supplied buffer.
+// Releasing a block does nothing, except when it's the last one; the buffer is
+// recycled as soon as all blocks are released (for example, after
+// JsonDocument::clear()). When the buffer is full, it forwards the requests to
+// the upstream allocator, if any.
+class MonotonicAllocator : public Allocator {
+ public:
+  MonotonicAllocator(void* buffer, size_t capacity,
+                     Allocator* upstream = nullptr)
+      : begin_(detail::addPadding(reinterpret_cast<char*>(buffer))),
+        end_(reinterpret_cast<char*>(buffer) + capacity),
+        upstream_(upstream) {
+    if (begin_ > end_)
+      begin_ = end_;
+    reset();
+  }
+
+  virtual ~MonotonicAllocator() = default;
+
+  MonotonicAllocator(const MonotonicAllocator&) = delete;
+  MonotonicAllocator& operator=(const MonotonicAllocator&) = delete;
+
+  void* allocate(size_t size) override {
+    auto block = allocateInBuffer(size);
+    if (block)
+      return block;
+    return upstream_ ? upstream_->allocate(size) : nullptr;
+  }
+
+  void deallocate(void* ptr) override {
+    if (!owns(ptr)) {
+      if (upstream_)
+        upstream_->deallocate(ptr);
+      return;
+    }
+    if (ptr == last_) {
+      cursor_ = static_cast<char*>(ptr) - headerSize;
+      last_ = nullptr;
+    }
+    if (--blocks_ == 0)
+      reset();
+  }
+
+  void* reallocate(void* ptr, size_t newSize) override {
+    if (!ptr)
+      return allocate(newSize);
+
+    if (!owns(ptr))
+      return upstream_ ? upstream_->reallocate(ptr, newSize) : nullptr;
+
+    size_t oldSize = blockSize(ptr);
+
+    // extend (or shrink) the last block in place
+    size_t available = size_t(end_ - static_cast<char*>(ptr));
+    if (ptr == last_ && newSize <= available &&
+        detail::addPadding(newSize) <= available) {
+      setBlockSize(ptr, newSize);
+      cursor_ = static_cast<char*>(ptr) + detail::addPadding(newSize);
+      return ptr;
+    }
+
+    if (newSize <= oldSize) {
+      setBlockSize(ptr, newSize);
+      return ptr;
+    }
+
+    auto newPtr = allocate(newSize);
+    if (!newPtr)
+      return nullptr;
+    memcpy(newPtr, ptr, oldSize);
+    deallocate(ptr);
+    return newPtr;
+  }
+
+  // Forgets all the blocks carved out of the buffer.
+  // Only call this when none of them is in use.
+  void reset() {
+    cursor_ = begin_;
+    last_ = nullptr;
+    blocks_ = 0;
+  }
+
+  // Returns the number of bytes consumed in the buffer
+  size_t size() const {
+    return size_t(cursor_ - begin_);
+  }
+
+  size_t capacity() const {
+    return size_t(end_ - begin_);
+  }
+
+  // Returns the number of bytes of the buffer that a block consumes
+  static size_t sizeofBlock(size_t size) {
+    return headerSize + detail::addPadding(size);
+  }
+
+ private:
+  // Each block is prefixed with its size so that reallocate() can copy it
+  static const size_t headerSize = detail::AddPadding<sizeof(size_t)>::value;
+
+  bool owns(void* ptr) const {
+    auto p = static_cast<char*>(ptr);
+    return p >= begin_ && p < end_;
+  }
+
+  void* allocateInBuffer(size_t size) {
+    size_t required = headerSize + detail::addPadding(size);
+    if (required < size || required > size_t(end_ - cursor_))
+      return nullptr;
+    auto block = cursor_ + headerSize;
+    setBlockSize(block, size);
+    cursor_ += required;
+    last_ = block;
+    blocks_++;
+    return block;
+  }
+
+  static size_t blockSize(void* block) {
+    size_t size;
+    memcpy(&size, static_cast<char*>(block) - headerSize, sizeof(size));
+    return size;
+  }
+
+  static void setBlockSize(void* block, size_t size) {
+    memcpy(static_cast<char*>(block) - headerSize, &size, sizeof(size));
+  }
+
+  char* begin_;
+  char* end_;
+  char* cursor_;
+  void* last_;
+  size_t blocks_;
+  Allocator* upstream_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -5,13 +5,20 @@
 #pragma once
 
 #include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/CollectionIndex.hpp>
 #include <ArduinoJson/Memory/MemoryPoolList.hpp>
+#include <ArduinoJson/Memory/StringArena.hpp>
 #include <ArduinoJson/Memory/StringPool.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/utility.hpp>
 #include <ArduinoJson/Strings/StringAdapters.hpp>
 #include <ArduinoJson/Variant/VariantData.hpp>
 
+#if ARDUINOJSON_ENABLE_STATS
+#  include <ArduinoJson/Memory/CountingAllocator.hpp>
+#  include <ArduinoJson/Memory/MemoryStats.hpp>
+#endif
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 class VariantData;
@@ -29,11 +36,22 @@ class ResourceManager {
   constexpr static size_t slotSize = sizeof(SlotData);
 
   ResourceManager(Allocator* allocator = DefaultAllocator::instance())
-      : allocator_(allocator), overflowed_(false) {}
+      : allocator_(allocator),
+#if ARDUINOJSON_ENABLE_STATS
+        peakUsage_(0),
+#endif
+        overflowed_(false),
+        reserved_(false),
+        generation_(0),
+        stringArena_(memoryAllocator()) {}
 
   ~ResourceManager() {
-    stringPool_.clear(allocator_);
-    variantPools_.clear(allocator_);
+    stringPool_.clear(stringAllocator(), memoryAllocator());
+    stringArena_.clear();
+    variantPools_.clear(memoryAllocator());
+#if ARDUINOJSON_USE_COLLECTION_INDEX
+    collectionIndexes_.clear(memoryAllocator());
+#endif
   }
 
   ResourceManager(const ResourceManager&) = delete;
@@ -42,12 +60,27 @@ class ResourceManager {
   friend void swap(ResourceManager& a, ResourceManager& b) {
     swap(a.stringPool_, b.stringPool_);
     swap(a.variantPools_, b.variantPools_);
+#if ARDUINOJSON_USE_COLLECTION_INDEX
+    swap(a.collectionIndexes_, b.collectionIndexes_);
+#endif
+#if ARDUINOJSON_ENABLE_STATS
+    swap(a.allocator_, b.allocator_);
+    swap_(a.peakUsage_, b.peakUsage_);
+#else
     swap_(a.allocator_, b.allocator_);
+#endif
     swap_(a.overflowed_, b.overflowed_);
+    swap_(a.reserved_, b.reserved_);
+    swap_(a.generation_, b.generation_);
+    swap(a.stringArena_, b.stringArena_);
   }
 
   Allocator* allocator() const {
+#if ARDUINOJSON_ENABLE_STATS
+    return allocator_.upstream();
+#else
     return allocator_;
+#endif
   }
 
   size_t size() const {
@@ -58,6 +91,19 @@ class ResourceManager {
     return overflowed_;
   }
 
+  // Returns true if reserve() was called since the last clear() or
+  // shrinkToFit(), in which case the deserializers reuse the memory instead
+  // of releasing it
+  bool reserved() const {
+    return reserved_;
+  }
+
+  // Changes every time a variant is released, so that iterators can tell
+  // whether the slot ids they remember are still valid
+  size_t generation() const {
+    return generation_;
+  }
+
   Slot<VariantData> allocVariant();
   void freeVariant(Slot<VariantData> slot);
   VariantData* getVariant(SlotId id) const;
@@ -73,15 +119,22 @@ class ResourceManager {
     if (str.isNull())
       return 0;
 
-    auto node = stringPool_.add(str, allocator_);
+    auto node = stringPool_.add(str, stringAllocator(), memoryAllocator());
     if (!node)
       overflowed_ = true;
+    updatePeakUsage();
 
     return node;
   }
 
   void saveString(StringNode* node) {
-    stringPool_.add(node);
+    stringPool_.add(node, memoryAllocator());
+    updatePeakUsage();
+  }
+
+  // Adds a reference to a string that's already in the pool
+  void reuseString(StringNode* node) {
+    stringPool_.addReference(node);
   }
 
   template <typename TAdaptedString>
@@ -90,42 +143,211 @@ class ResourceManager {
   }
 
   StringNode* createString(size_t length) {
-    auto node = StringNode::create(length, allocator_);
+    auto node = StringNode::create(length, stringAllocator());
     if (!node)
       overflowed_ = true;
     return node;
   }
 
   StringNode* resizeString(StringNode* node, size_t length) {
-    node = StringNode::resize(node, length, allocator_);
+    node = StringNode::resize(node, length, stringAllocator());
     if (!node)
       overflowed_ = true;
     return node;
   }
 
   void destroyString(StringNode* node) {
-    StringNode::destroy(node, allocator_);
+    StringNode::destroy(node, stringAllocator());
   }
 
   void dereferenceString(const char* s) {
-    stringPool_.dereference(s, allocator_);
+    stringPool_.dereference(s, stringAllocator());
+  }
+
+#if ARDUINOJSON_USE_COLLECTION_INDEX
+  // Collection indexes are caches attached to the collections; only the
+  // methods that modify a collection create or update them
+  CollectionIndex* getCollectionIndex(SlotId owner) const {
+    return collectionIndexes_.find(owner);
   }
 
+  CollectionIndex* createCollectionIndex(SlotId owner) {
+    return collectionIndexes_.create(owner, memoryAllocator());
+  }
+
+  bool resizeCollectionIndex(CollectionIndex* index, size_t capacity) {
+    return index->resize(capacity, memoryAllocator());
+  }
+
+  void destroyCollectionIndex(SlotId owner) {
+    collectionIndexes_.destroy(owner, memoryAllocator());
+  }
+
+  void moveCollectionIndex(SlotId from, SlotId to) {
+    collectionIndexes_.move(from, to);
+  }
+#endif
+
   void clear() {
-    variantPools_.clear(allocator_);
+    variantPools_.clear(memoryAllocator());
     overflowed_ = false;
-    stringPool_.clear(allocator_);
+    reserved_ = false;
+    generation_++;
+    stringPool_.clear(stringAllocator(), memoryAllocator());
+    stringArena_.clear();
+#if ARDUINOJSON_USE_COLLECTION_INDEX
+    collectionIndexes_.clear(memoryAllocator());
+#endif
+  }
+
+  // Like clear(), but keeps the memory pools for future allocations
+  void reset() {
+    variantPools_.reset();
+    overflowed_ = false;
+    generation_++;
+    stringPool_.clear(stringAllocator(), memoryAllocator());
+#if ARDUINOJSON_USE_COLLECTION_INDEX
+    collectionIndexes_.clear(memoryAllocator());
+#endif
+  }
+
+  // Moves the slots and the strings of src into this instance, see
+  // MemoryPoolList::append() and StringPool::merge().
+  // The variants of src must then be updated with VariantData::rebase().
+  // Returns false if the slots don't fit, or if allocation fails.
+  bool merge(ResourceManager& src, SlotId& offset) {
+    if (!variantPools_.append(src.variantPools_, offset, memoryAllocator()))
+      return false;
+    stringPool_.merge(src.stringPool_, memoryAllocator());
+#if ARDUINOJSON_USE_COLLECTION_INDEX
+    // the slot ids changed, VariantData::rebase() recreates the indexes
+    src.collectionIndexes_.clear(memoryAllocator());
+#endif
+#if ARDUINOJSON_ENABLE_STATS
+    addStats(src);
+    updatePeakUsage();
+#endif
+    if (src.overflowed_)
+      overflowed_ = true;
+    return true;
+  }
+
+  // Returns the string of this instance that replaces a string of an instance
+  // that was merged
+  StringNode* adoptString(StringNode* node) {
+    auto existing = stringPool_.get(adaptString(node->data, node->length));
+    ARDUINOJSON_ASSERT(existing != nullptr);
+    if (existing != node) {
+      reuseString(existing);
+      if (--node->references == 0)
+        destroyString(node);
+    }
+    return existing;
+  }
+
+  // Allocates enough memory for the specified number of slots, and reserves a
+  // buffer for the strings.
+  // Returns false if allocation fails.
+  bool reserve(size_t slots, size_t stringBytes) {
+    reserved_ = true;
+    if (!variantPools_.reserve(slots, memoryAllocator()))
+      return false;
+    return stringBytes == 0 || stringArena_.reserve(stringBytes);
+  }
+
+  // Copies the allocation settings of another instance, but not the content
+  void copySettings(const ResourceManager& src) {
+    variantPools_.setMaxPoolCapacity(src.variantPools_.maxPoolCapacity());
+    stringArena_.setGrowing(src.stringArena_.growing());
+  }
+
+  bool setMaxPoolCapacity(size_t slots) {
+    return variantPools_.setMaxPoolCapacity(slots);
+  }
+
+  size_t maxPoolCapacity() const {
+    return variantPools_.maxPoolCapacity();
+  }
+
+  // When enabled, the strings are allocated in large chunks and their memory
+  // is only recycled when the document is cleared.
+  void useStringArena(bool enabled) {
+    stringArena_.setGrowing(enabled);
   }
 
+#if ARDUINOJSON_ENABLE_STATS
+  // Adds the cumulative counters of stats() of an instance whose content was
+  // moved to this one
+  void addStats(const ResourceManager& src) {
+    allocator_.addCounters(src.allocator_);
+    stringPool_.addDedupHits(src.stringPool_.dedupHits());
+    if (src.peakUsage_ > peakUsage_)
+      peakUsage_ = src.peakUsage_;
+  }
+
+  MemoryStats stats() const {
+    MemoryStats stats;
+    stats.slotsUsed = variantPools_.usedSlots();
+    stats.slotsFree = variantPools_.freeSlots();
+    stats.poolCount = variantPools_.poolCount();
+    stats.stringCount = stringPool_.count();
+    stats.stringBytes = stringPool_.size();
+    stats.dedupHits = stringPool_.dedupHits();
+    stats.allocatorCalls = allocator_.calls();
+    stats.allocatedBytes = allocator_.bytes();
+    stats.peakUsage = peakUsage_;
+    return stats;
+  }
+#endif
+
   void shrinkToFit() {
-    variantPools_.shrinkToFit(allocator_);
+    reserved_ = false;
+    variantPools_.shrinkToFit(memoryAllocator());
+    stringArena_.shrinkToFit();
   }
 
  private:
+  void updatePeakUsage() {
+#if ARDUINOJSON_ENABLE_STATS
+    auto usage = variantPools_.usedSlots() * slotSize + stringPool_.size();
+    if (usage > peakUsage_)
+      peakUsage_ = usage;
+#endif
+  }
+
+  // The allocator of the pools and the indexes; it counts the calls when the
+  // stats are enabled
+  Allocator* memoryAllocator() {
+#if ARDUINOJSON_ENABLE_STATS
+    return &allocator_;
+#else
+    return allocator_;
+#endif
+  }
+
+  // Strings go through the arena when it's in use; the arena forwards to
+  // memoryAllocator() the strings it doesn't own
+  Allocator* stringAllocator() {
+    if (stringArena_.active())
+      return &stringArena_;
+    return memoryAllocator();
+  }
+
+#if ARDUINOJSON_ENABLE_STATS
+  CountingAllocator allocator_;
+  size_t peakUsage_;
+#else
   Allocator* allocator_;
+#endif
   bool overflowed_;
+  bool reserved_;
+  size_t generation_;
+  StringArena stringArena_;
   StringPool stringPool_;
   MemoryPoolList<SlotData> variantPools_;
+#if ARDUINOJSON_USE_COLLECTION_INDEX
+  CollectionIndexMap collectionIndexes_;
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
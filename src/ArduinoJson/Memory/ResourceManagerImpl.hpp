@@ -12,16 +12,18 @@
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 inline Slot<VariantData> ResourceManager::allocVariant() {
-  auto p = variantPools_.allocSlot(allocator_);
+  auto p = variantPools_.allocSlot(memoryAllocator());
   if (!p) {
     overflowed_ = true;
     return {};
   }
+  updatePeakUsage();
   return {new (&p->variant) VariantData, p.id()};
 }
 
 inline void ResourceManager::freeVariant(Slot<VariantData> variant) {
   variant->clear(this);
+  generation_++;
   variantPools_.freeSlot({alias_cast<SlotData*>(variant.ptr()), variant.id()});
 }
 
@@ -31,11 +33,12 @@ inline VariantData* ResourceManager::getVariant(SlotId id) const {
 
 #if ARDUINOJSON_USE_EXTENSIONS
 inline Slot<VariantExtension> ResourceManager::allocExtension() {
-  auto p = variantPools_.allocSlot(allocator_);
+  auto p = variantPools_.allocSlot(memoryAllocator());
   if (!p) {
     overflowed_ = true;
     return {};
   }
+  updatePeakUsage();
   return {&p->extension, p.id()};
 }
 
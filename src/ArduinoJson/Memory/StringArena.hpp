@@ -0,0 +1,245 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Alignment.hpp>
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/StringNode.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Allocates the StringNodes of a document in large chunks.
+// Releasing a string only gives the memory back if it's the last one of its
+// chunk; the chunks are rewound when all the strings are released.
+// When the chunks are full, it either adds a new chunk (if growing is enabled)
+// or forwards the request to the upstream allocator.
+// NOTE: this allocator must only be used for StringNodes because it reads the
+// length of the node to know the size of a block.
+class StringArena final : public Allocator {
+  struct Chunk {
+    Chunk* next;
+    size_t capacity;
+    size_t usage;
+    size_t blocks;     // number of strings in the chunk
+    StringNode* last;  // last string of the chunk, or null
+
+    char* data() {
+      return reinterpret_cast<char*>(this) + headerSize;
+    }
+
+    bool contains(const void* p) {
+      auto c = static_cast<const char*>(p);
+      return c >= data() && c < data() + capacity;
+    }
+  };
+
+  static const size_t headerSize = AddPadding<sizeof(Chunk)>::value;
+
+ public:
+  static const size_t initialChunkSize = 256;
+  static const size_t maxChunkSize = 16384;
+
+  StringArena(Allocator* upstream) : upstream_(upstream) {}
+  StringArena(const StringArena&) = delete;
+  StringArena& operator=(const StringArena&) = delete;
+
+  ~StringArena() {
+    ARDUINOJSON_ASSERT(chunks_ == nullptr);
+  }
+
+  // The upstream allocators are not swapped, because they belong to the owners
+  friend void swap(StringArena& a, StringArena& b) {
+    swap_(a.chunks_, b.chunks_);
+    swap_(a.current_, b.current_);
+    swap_(a.blocks_, b.blocks_);
+    swap_(a.growing_, b.growing_);
+  }
+
+  // Is this allocator needed, or can we use the upstream allocator directly?
+  bool active() const {
+    return growing_ || chunks_ != nullptr;
+  }
+
+  // When enabled, the arena adds chunks as needed instead of forwarding to the
+  // upstream allocator
+  void setGrowing(bool enabled) {
+    growing_ = enabled;
+  }
+
+  bool growing() const {
+    return growing_;
+  }
+
+  // Makes sure the current chunk can hold n bytes of strings
+  bool reserve(size_t n) {
+    if (current_ && current_->capacity - current_->usage >= n)
+      return true;
+    auto capacity = addPadding(n);
+    if (capacity < n)  // integer overflow
+      return false;
+    return addChunk(capacity) != nullptr;
+  }
+
+  // Returns the number of bytes allocated for a chunk of the specified capacity
+  static size_t sizeofChunk(size_t capacity) {
+    return headerSize + capacity;
+  }
+
+  // Returns the number of bytes used in the chunks
+  size_t size() const {
+    size_t total = 0;
+    for (auto chunk = chunks_; chunk; chunk = chunk->next)
+      total += chunk->usage;
+    return total;
+  }
+
+  void* allocate(size_t size) override {
+    auto padded = addPadding(size);
+    if (padded < size)  // integer overflow
+      return nullptr;
+    while (current_ && current_->capacity - current_->usage < padded)
+      current_ = current_->next;
+    if (!current_ && (!growing_ || !addChunk(nextChunkCapacity(padded))))
+      return upstream_->allocate(size);
+    auto block = current_->data() + current_->usage;
+    current_->usage += padded;
+    current_->blocks++;
+    current_->last = reinterpret_cast<StringNode*>(block);
+    blocks_++;
+    return block;
+  }
+
+  void deallocate(void* ptr) override {
+    auto chunk = findChunk(ptr);
+    if (!chunk) {
+      upstream_->deallocate(ptr);
+      return;
+    }
+    if (ptr == chunk->last) {
+      chunk->usage = size_t(static_cast<char*>(ptr) - chunk->data());
+      chunk->last = nullptr;
+    }
+    if (--chunk->blocks == 0)
+      chunk->usage = 0;
+    if (--blocks_ == 0)
+      current_ = chunks_;
+  }
+
+  void* reallocate(void* ptr, size_t newSize) override {
+    auto chunk = findChunk(ptr);
+    if (!chunk)
+      return upstream_->reallocate(ptr, newSize);
+
+    auto offset = size_t(static_cast<char*>(ptr) - chunk->data());
+    auto padded = addPadding(newSize);
+    if (ptr == chunk->last && padded >= newSize &&
+        padded <= chunk->capacity - offset) {
+      chunk->usage = offset + padded;
+      return ptr;
+    }
+
+    auto node = static_cast<StringNode*>(ptr);
+    auto oldSize = StringNode::sizeForLength(node->length);
+    if (newSize <= oldSize)
+      return ptr;
+
+    auto newPtr = allocate(newSize);
+    if (!newPtr)
+      return nullptr;
+    memcpy(newPtr, ptr, oldSize);
+    deallocate(ptr);
+    return newPtr;
+  }
+
+  // Releases the chunks that contain no string
+  void shrinkToFit() {
+    Chunk** prev = &chunks_;
+    while (*prev) {
+      auto chunk = *prev;
+      if (chunk->blocks == 0) {
+        *prev = chunk->next;
+        upstream_->deallocate(chunk);
+      } else {
+        prev = &chunk->next;
+      }
+    }
+    current_ = chunks_;
+    while (current_ && current_->next)
+      current_ = current_->next;
+  }
+
+  // Releases all the chunks; all the strings must have been released
+  void clear() {
+    ARDUINOJSON_ASSERT(blocks_ == 0);
+    while (chunks_) {
+      auto chunk = chunks_;
+      chunks_ = chunk->next;
+      upstream_->deallocate(chunk);
+    }
+    current_ = nullptr;
+  }
+
+ private:
+  Chunk* findChunk(void* ptr) const {
+    for (auto chunk = chunks_; chunk; chunk = chunk->next) {
+      if (chunk->contains(ptr))
+        return chunk;
+    }
+    return nullptr;
+  }
+
+  Chunk* lastChunk() const {
+    auto chunk = chunks_;
+    while (chunk && chunk->next)
+      chunk = chunk->next;
+    return chunk;
+  }
+
+  // Each chunk is twice as big as the previous one, up to maxChunkSize
+  size_t nextChunkCapacity(size_t minCapacity) const {
+    auto tail = lastChunk();
+    size_t capacity = tail ? tail->capacity * 2 : initialChunkSize;
+    if (capacity > maxChunkSize)
+      capacity = maxChunkSize;
+    if (capacity < minCapacity)
+      capacity = minCapacity;
+    return capacity;
+  }
+
+  // Appends a chunk, and makes it the current one
+  Chunk* addChunk(size_t capacity) {
+    if (headerSize + capacity < capacity)  // integer overflow
+      return nullptr;
+
+    auto chunk =
+        reinterpret_cast<Chunk*>(upstream_->allocate(headerSize + capacity));
+    if (!chunk)
+      return nullptr;
+    chunk->next = nullptr;
+    chunk->capacity = capacity;
+    chunk->usage = 0;
+    chunk->blocks = 0;
+    chunk->last = nullptr;
+    auto tail = lastChunk();
+    if (tail)
+      tail->next = chunk;
+    else
+      chunks_ = chunk;
+    current_ = chunk;
+    return chunk;
+  }
+
+  Allocator* upstream_;
+  Chunk* chunks_ = nullptr;   // oldest first
+  Chunk* current_ = nullptr;  // the chunk where we allocate
+  size_t blocks_ = 0;         // number of strings in all chunks
+  bool growing_ = false;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -37,7 +37,7 @@ class StringBuffer {
     node_->data[size_] = 0;
     auto node = resources_->getString(adaptString(node_->data, size_));
     if (node) {
-      node->references++;
+      resources_->reuseString(node);
       return node;
     }
 
@@ -55,7 +55,7 @@ class StringBuffer {
   JsonString str() const {
     ARDUINOJSON_ASSERT(node_ != nullptr);
 
-    return JsonString(node_->data, node_->length, JsonString::Copied);
+    return JsonString(node_->data, size_, JsonString::Copied);
   }
 
  private:
@@ -6,6 +6,8 @@
 
 #include <ArduinoJson/Memory/ResourceManager.hpp>
 
+#include <string.h>  // memcpy, strlen
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 class StringBuilder {
@@ -14,9 +16,23 @@ class StringBuilder {
 
   StringBuilder(ResourceManager* resources) : resources_(resources) {}
 
+  StringBuilder(const StringBuilder&) = delete;
+  StringBuilder& operator=(const StringBuilder&) = delete;
+
+  StringBuilder(StringBuilder&& src)
+      : resources_(src.resources_), node_(src.node_), size_(src.size_) {
+    src.node_ = nullptr;
+  }
+
   ~StringBuilder() {
+    release();
+  }
+
+  // Destroys the string being built, if any
+  void release() {
     if (node_)
       resources_->destroyString(node_);
+    node_ = nullptr;
   }
 
   void startString() {
@@ -35,24 +51,25 @@ class StringBuilder {
       resources_->saveString(node);
       node_ = nullptr;  // next time we need a new string
     } else {
-      node->references++;
+      resources_->reuseString(node);
     }
     return node;
   }
 
   void append(const char* s) {
-    while (*s)
-      append(*s++);
+    append(s, strlen(s));
   }
 
   void append(const char* s, size_t n) {
-    while (n-- > 0)  // TODO: memcpy
-      append(*s++);
+    if (!reserve(n))
+      return;
+    memcpy(node_->data + size_, s, n);
+    size_ += n;
   }
 
   void append(char c) {
     if (node_ && size_ == node_->length)
-      node_ = resources_->resizeString(node_, size_ * 2U + 1);
+      grow(1);
     if (node_)
       node_->data[size_++] = c;
   }
@@ -65,6 +82,11 @@ class StringBuilder {
     return size_;
   }
 
+  // Tells whether s points to the string being built
+  bool holds(JsonString s) const {
+    return node_ && s.c_str() == node_->data;
+  }
+
   JsonString str() const {
     ARDUINOJSON_ASSERT(node_ != nullptr);
     node_->data[size_] = 0;
@@ -72,6 +94,29 @@ class StringBuilder {
   }
 
  private:
+  // Makes sure the string can hold n more characters
+  bool reserve(size_t n) {
+    if (!node_)
+      return false;
+    if (node_->length - size_ >= n)
+      return true;
+    grow(n);
+    return node_ != nullptr;
+  }
+
+  // Doubles the capacity, or more if n characters don't fit
+  void grow(size_t n) {
+    size_t required = size_ + n;
+    if (required < n)         // integer overflow
+      required = size_t(-1);  // (not testable on 64-bit)
+    size_t capacity = node_->length * 2U + 1;
+    if (capacity < required)
+      capacity = required;
+    if (capacity > StringNode::maxLength && required <= StringNode::maxLength)
+      capacity = StringNode::maxLength;
+    node_ = resources_->resizeString(node_, capacity);
+  }
+
   ResourceManager* resources_;
   StringNode* node_ = nullptr;
   size_t size_ = 0;
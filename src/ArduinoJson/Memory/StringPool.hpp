@@ -10,67 +10,179 @@
 #include <ArduinoJson/Polyfills/utility.hpp>
 #include <ArduinoJson/Strings/StringAdapters.hpp>
 
+#include <stddef.h>  // offsetof
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 class StringPool {
  public:
+#if ARDUINOJSON_ENABLE_STRING_POOL_INDEX
+  // Number of strings in the list before we build the hash index
+  static const size_t indexThreshold = 16;
+#endif
+
   StringPool() = default;
   StringPool(const StringPool&) = delete;
   void operator=(StringPool&& src) = delete;
 
   ~StringPool() {
     ARDUINOJSON_ASSERT(strings_ == nullptr);
+#if ARDUINOJSON_ENABLE_STRING_POOL_INDEX
+    ARDUINOJSON_ASSERT(index_ == nullptr);
+#endif
   }
 
   friend void swap(StringPool& a, StringPool& b) {
     swap_(a.strings_, b.strings_);
+    swap_(a.size_, b.size_);
+#if ARDUINOJSON_ENABLE_STATS
+    swap_(a.count_, b.count_);
+    swap_(a.dedupHits_, b.dedupHits_);
+#endif
+#if ARDUINOJSON_ENABLE_STRING_POOL_INDEX
+    swap_(a.listCount_, b.listCount_);
+    swap_(a.index_, b.index_);
+    swap_(a.indexCapacity_, b.indexCapacity_);
+    swap_(a.indexCount_, b.indexCount_);
+#endif
   }
 
-  void clear(Allocator* allocator) {
+  // The strings are released with stringAllocator, the index with allocator
+  void clear(Allocator* stringAllocator, Allocator* allocator) {
     while (strings_) {
       auto node = strings_;
       strings_ = node->next;
-      StringNode::destroy(node, allocator);
+      StringNode::destroy(node, stringAllocator);
+    }
+    size_ = 0;
+#if ARDUINOJSON_ENABLE_STATS
+    count_ = 0;
+#endif
+#if ARDUINOJSON_ENABLE_STRING_POOL_INDEX
+    listCount_ = 0;
+    if (index_) {
+      for (size_t i = 0; i < indexCapacity_; i++) {
+        if (index_[i])
+          StringNode::destroy(index_[i], stringAllocator);
+      }
+      allocator->deallocate(index_);
+      index_ = nullptr;
+      indexCapacity_ = 0;
+      indexCount_ = 0;
     }
+#else
+    (void)allocator;
+#endif
   }
 
+  // Returns the number of bytes used by the strings
   size_t size() const {
-    size_t total = 0;
-    for (auto node = strings_; node; node = node->next)
-      total += sizeofString(node->length);
-    return total;
+    return size_;
+  }
+
+#if ARDUINOJSON_ENABLE_STATS
+  // Returns the number of strings
+  size_t count() const {
+    return count_;
+  }
+
+  // Returns the number of times a string was reused instead of copied
+  size_t dedupHits() const {
+    return dedupHits_;
+  }
+
+  void addDedupHits(size_t n) {
+    dedupHits_ += n;
   }
+#endif
 
   template <typename TAdaptedString>
-  StringNode* add(TAdaptedString str, Allocator* allocator) {
+  StringNode* add(TAdaptedString str, Allocator* stringAllocator,
+                  Allocator* allocator) {
     ARDUINOJSON_ASSERT(str.isNull() == false);
 
     auto node = get(str);
     if (node) {
-      node->references++;
+      addReference(node);
       return node;
     }
 
     size_t n = str.size();
 
-    node = StringNode::create(n, allocator);
+    node = StringNode::create(n, stringAllocator);
     if (!node)
       return nullptr;
 
     stringGetChars(str, node->data, n);
     node->data[n] = 0;  // force NUL terminator
-    add(node);
+    add(node, allocator);
     return node;
   }
 
-  void add(StringNode* node) {
+  // The allocator is only used for the index
+  void add(StringNode* node, Allocator* allocator) {
     ARDUINOJSON_ASSERT(node != nullptr);
+    size_ += sizeofString(node->length);
+#if ARDUINOJSON_ENABLE_STATS
+    count_++;
+#endif
+#if ARDUINOJSON_ENABLE_STRING_POOL_INDEX
+    if (addToIndex(node, allocator))
+      return;
+    listCount_++;
+#else
+    (void)allocator;
+#endif
     node->next = strings_;
     strings_ = node;
   }
 
+  // Moves the strings of src into this pool, except the ones that are already
+  // here; these are detached from both pools and must be replaced with
+  // ResourceManager::adoptString()
+  void merge(StringPool& src, Allocator* allocator) {
+    while (src.strings_) {
+      auto node = src.strings_;
+      src.strings_ = node->next;
+      mergeNode(node, allocator);
+    }
+#if ARDUINOJSON_ENABLE_STRING_POOL_INDEX
+    src.listCount_ = 0;
+    if (src.index_) {
+      for (size_t i = 0; i < src.indexCapacity_; i++) {
+        if (src.index_[i])
+          mergeNode(src.index_[i], allocator);
+      }
+      allocator->deallocate(src.index_);
+      src.index_ = nullptr;
+      src.indexCapacity_ = 0;
+      src.indexCount_ = 0;
+    }
+#endif
+    src.size_ = 0;
+#if ARDUINOJSON_ENABLE_STATS
+    src.count_ = 0;
+#endif
+  }
+
+  void addReference(StringNode* node) {
+    node->references++;
+#if ARDUINOJSON_ENABLE_STATS
+    dedupHits_++;
+#endif
+  }
+
   template <typename TAdaptedString>
   StringNode* get(const TAdaptedString& str) const {
+#if ARDUINOJSON_ENABLE_STRING_POOL_INDEX
+    if (index_) {
+      for (auto i = firstIndexSlot(stringHash(str)); index_[i];
+           i = nextIndexSlot(i)) {
+        if (stringEquals(str, adaptString(index_[i]->data, index_[i]->length)))
+          return index_[i];
+      }
+    }
+#endif
     for (auto node = strings_; node; node = node->next) {
       if (stringEquals(str, adaptString(node->data, node->length)))
         return node;
@@ -78,7 +190,12 @@ class StringPool {
     return nullptr;
   }
 
-  void dereference(const char* s, Allocator* allocator) {
+  // The allocator must be the one that created the string
+  void dereference(const char* s, Allocator* stringAllocator) {
+#if ARDUINOJSON_ENABLE_STRING_POOL_INDEX
+    if (index_ && dereferenceFromIndex(s, stringAllocator))
+      return;
+#endif
     StringNode* prev = nullptr;
     for (auto node = strings_; node; node = node->next) {
       if (node->data == s) {
@@ -87,7 +204,11 @@ class StringPool {
             prev->next = node->next;
           else
             strings_ = node->next;
-          StringNode::destroy(node, allocator);
+          forget(node);
+          StringNode::destroy(node, stringAllocator);
+#if ARDUINOJSON_ENABLE_STRING_POOL_INDEX
+          listCount_--;
+#endif
         }
         return;
       }
@@ -96,7 +217,135 @@ class StringPool {
   }
 
  private:
+  void mergeNode(StringNode* node, Allocator* allocator) {
+    if (!get(adaptString(node->data, node->length)))
+      add(node, allocator);
+  }
+
+  // Updates the counters when a string is removed
+  void forget(const StringNode* node) {
+    size_ -= sizeofString(node->length);
+#if ARDUINOJSON_ENABLE_STATS
+    count_--;
+#endif
+  }
+
+#if ARDUINOJSON_ENABLE_STRING_POOL_INDEX
+  // The index is an open-addressing hash table with linear probing.
+  // Its capacity is a power of two, and it's never more than half full.
+
+  static uint32_t hashNode(const StringNode* node) {
+    return stringHash(adaptString(node->data, node->length));
+  }
+
+  size_t firstIndexSlot(uint32_t hash) const {
+    return hash & (indexCapacity_ - 1);
+  }
+
+  size_t nextIndexSlot(size_t i) const {
+    return (i + 1) & (indexCapacity_ - 1);
+  }
+
+  bool addToIndex(StringNode* node, Allocator* allocator) {
+    if (!index_ && listCount_ < indexThreshold)
+      return false;
+    if ((indexCount_ + listCount_ + 1) * 2 > indexCapacity_ &&
+        !growIndex(allocator))
+      return false;
+    insertInIndex(node);
+    return true;
+  }
+
+  void insertInIndex(StringNode* node) {
+    auto i = firstIndexSlot(hashNode(node));
+    while (index_[i])
+      i = nextIndexSlot(i);
+    index_[i] = node;
+    indexCount_++;
+  }
+
+  bool growIndex(Allocator* allocator) {
+    auto newCapacity = indexCapacity_ ? indexCapacity_ * 2 : indexThreshold * 4;
+    auto newIndex = reinterpret_cast<StringNode**>(
+        allocator->allocate(newCapacity * sizeof(StringNode*)));
+    if (!newIndex)
+      return false;
+    for (size_t i = 0; i < newCapacity; i++)
+      newIndex[i] = nullptr;
+
+    auto oldIndex = index_;
+    auto oldCapacity = indexCapacity_;
+    index_ = newIndex;
+    indexCapacity_ = newCapacity;
+    indexCount_ = 0;
+
+    for (size_t i = 0; i < oldCapacity; i++) {
+      if (oldIndex[i])
+        insertInIndex(oldIndex[i]);
+    }
+    if (oldIndex)
+      allocator->deallocate(oldIndex);
+
+    // move the strings that were in the list
+    while (strings_) {
+      auto node = strings_;
+      strings_ = node->next;
+      insertInIndex(node);
+    }
+    listCount_ = 0;
+
+    return true;
+  }
+
+  bool dereferenceFromIndex(const char* s, Allocator* stringAllocator) {
+    void* p = const_cast<char*>(s) - offsetof(StringNode, data);
+    auto node = static_cast<StringNode*>(p);
+    auto i = firstIndexSlot(hashNode(node));
+    while (index_[i] != node) {
+      if (!index_[i])
+        return false;  // not in the index, must be in the list
+      i = nextIndexSlot(i);
+    }
+    if (--node->references == 0) {
+      removeFromIndex(i);
+      forget(node);
+      StringNode::destroy(node, stringAllocator);
+    }
+    return true;
+  }
+
+  // Backward-shift deletion: moves the following entries of the cluster to
+  // fill the hole, so we never need tombstones
+  void removeFromIndex(size_t hole) {
+    auto i = nextIndexSlot(hole);
+    while (index_[i]) {
+      auto home = firstIndexSlot(hashNode(index_[i]));
+      // can the entry at i move to the hole? (i.e., is home outside ]hole,i]?)
+      bool canMove = hole < i ? (home <= hole || home > i)
+                              : (home <= hole && home > i);
+      if (canMove) {
+        index_[hole] = index_[i];
+        hole = i;
+      }
+      i = nextIndexSlot(i);
+    }
+    index_[hole] = nullptr;
+    indexCount_--;
+  }
+#endif
+
   StringNode* strings_ = nullptr;
+  size_t size_ = 0;
+#if ARDUINOJSON_ENABLE_STATS
+  size_t count_ = 0;
+  size_t dedupHits_ = 0;
+#endif
+#if ARDUINOJSON_ENABLE_STRING_POOL_INDEX
+  size_t listCount_ = 0;
+  StringNode** index_ = nullptr;
+  size_t indexCapacity_ = 0;
+  size_t indexCount_ = 0;
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -31,6 +31,13 @@ class MsgPackDeserializer {
     return foundSomething_ ? err : DeserializationError::EmptyInput;
   }
 
+  DeserializationError parse(JsonHandler& handler,
+                             DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+    err = parseVariant(&handler, nestingLimit);
+    return foundSomething_ ? err : DeserializationError::EmptyInput;
+  }
+
  private:
   template <typename TFilter>
   DeserializationError::Code parseVariant(
@@ -95,9 +102,115 @@ class MsgPackDeserializer {
       return DeserializationError::Ok;
     }
 
-    uint8_t sizeBytes = 0;
-    size_t size = 0;
-    bool isExtension = code >= 0xc7 && code <= 0xc9;
+    uint8_t sizeBytes;
+    size_t size;
+    err = readSize(header, sizeBytes, size);
+    if (err)
+      return err;
+
+    if (isArray(code))
+      return readArray(variant, size, filter, nestingLimit);
+
+    if (isMap(code))
+      return readObject(variant, size, filter, nestingLimit);
+
+    if (isString(code)) {
+      if (allowValue)
+        return readString(variant, size);
+      else
+        return skipBytes(size);
+    }
+
+    if (isExtension(code))
+      size++;  // to include the type
+
+    if (allowValue)
+      return readRawString(variant, header, uint8_t(1 + sizeBytes), size);
+    else
+      return skipBytes(size);
+  }
+
+  // Sends the value to the handler instead of storing it
+  DeserializationError::Code parseVariant(
+      JsonHandler* handler, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    uint8_t header[5];
+    err = readBytes(header, 1);
+    if (err)
+      return err;
+
+    const uint8_t& code = header[0];
+
+    foundSomething_ = true;
+
+    if (code >= 0xcc && code <= 0xd3) {
+      auto width = uint8_t(1U << ((code - 0xcc) % 4));
+      return readInteger(handler, width, code >= 0xd0);
+    }
+
+    switch (code) {
+      case 0xc0:
+        handler->onNull();
+        return DeserializationError::Ok;
+
+      case 0xc1:
+        return DeserializationError::InvalidInput;
+
+      case 0xc2:
+      case 0xc3:
+        handler->onBoolean(code == 0xc3);
+        return DeserializationError::Ok;
+
+      case 0xca:
+        return readFloat<float>(handler);
+
+      case 0xcb:
+        return readDouble<double>(handler);
+    }
+
+    if (code <= 0x7f || code >= 0xe0) {  // fixint
+      handler->onInteger(static_cast<int8_t>(code));
+      return DeserializationError::Ok;
+    }
+
+    uint8_t sizeBytes;
+    size_t size;
+    err = readSize(header, sizeBytes, size);
+    if (err)
+      return err;
+
+    if (isArray(code))
+      return readArray(handler, size, nestingLimit);
+
+    if (isMap(code))
+      return readObject(handler, size, nestingLimit);
+
+    if (isString(code)) {
+      err = readString(size);
+      if (!err)
+        handler->onString(stringBuffer_.str());
+      return err;
+    }
+
+    if (isExtension(code))
+      size++;  // to include the type
+
+    err = readRawString(header, uint8_t(1 + sizeBytes), size);
+    if (!err)
+      handler->onRawValue(stringBuffer_.str());
+    return err;
+  }
+
+  // Reads the size of a string, a binary, an extension, an array, or a map.
+  // The size is either in the type code or in the following bytes, which are
+  // appended to the header.
+  DeserializationError::Code readSize(uint8_t* header, uint8_t& sizeBytes,
+                                      size_t& size) {
+    const uint8_t& code = header[0];
+
+    sizeBytes = 0;
+    size = 0;
 
     switch (code) {
       case 0xc4:  // bin 8
@@ -123,10 +236,8 @@ class MsgPackDeserializer {
         break;
     }
 
-    if (code >= 0xd4 && code <= 0xd8) {  // fixext
+    if (code >= 0xd4 && code <= 0xd8)  // fixext
       size = size_t(1) << (code - 0xd4);
-      isExtension = true;
-    }
 
     switch (code & 0xf0) {
       case 0x90:  // fixarray
@@ -142,7 +253,7 @@ class MsgPackDeserializer {
     }
 
     if (sizeBytes) {
-      err = readBytes(header + 1, sizeBytes);
+      auto err = readBytes(header + 1, sizeBytes);
       if (err)
         return err;
 
@@ -155,29 +266,28 @@ class MsgPackDeserializer {
         return DeserializationError::NoMemory;  // (not testable on 32/64-bit)
     }
 
-    // array 16, 32 and fixarray
-    if (code == 0xdc || code == 0xdd || (code & 0xf0) == 0x90)
-      return readArray(variant, size, filter, nestingLimit);
+    return DeserializationError::Ok;
+  }
 
-    // map 16, 32 and fixmap
-    if (code == 0xde || code == 0xdf || (code & 0xf0) == 0x80)
-      return readObject(variant, size, filter, nestingLimit);
+  // array 16, 32 and fixarray
+  static bool isArray(uint8_t code) {
+    return code == 0xdc || code == 0xdd || (code & 0xf0) == 0x90;
+  }
 
-    // str 8, 16, 32 and fixstr
-    if (code == 0xd9 || code == 0xda || code == 0xdb || (code & 0xe0) == 0xa0) {
-      if (allowValue)
-        return readString(variant, size);
-      else
-        return skipBytes(size);
-    }
+  // map 16, 32 and fixmap
+  static bool isMap(uint8_t code) {
+    return code == 0xde || code == 0xdf || (code & 0xf0) == 0x80;
+  }
 
-    if (isExtension)
-      size++;  // to include the type
+  // str 8, 16, 32 and fixstr
+  static bool isString(uint8_t code) {
+    return code == 0xd9 || code == 0xda || code == 0xdb ||
+           (code & 0xe0) == 0xa0;
+  }
 
-    if (allowValue)
-      return readRawString(variant, header, uint8_t(1 + sizeBytes), size);
-    else
-      return skipBytes(size);
+  // ext 8, 16, 32 and fixext
+  static bool isExtension(uint8_t code) {
+    return (code >= 0xc7 && code <= 0xc9) || (code >= 0xd4 && code <= 0xd8);
   }
 
   DeserializationError::Code readByte(uint8_t& value) {
@@ -207,7 +317,9 @@ class MsgPackDeserializer {
     return DeserializationError::Ok;
   }
 
-  DeserializationError::Code readInteger(VariantData* variant, uint8_t width,
+  // TTarget is VariantData* or JsonHandler*
+  template <typename TTarget>
+  DeserializationError::Code readInteger(TTarget target, uint8_t width,
                                          bool isSigned) {
     uint8_t buffer[8];
 
@@ -230,25 +342,62 @@ class MsgPackDeserializer {
 
     if (isSigned) {
       auto truncatedValue = static_cast<JsonInteger>(signedValue);
-      if (truncatedValue == signedValue) {
-        if (!variant->setInteger(truncatedValue, resources_))
-          return DeserializationError::NoMemory;
-      }
-      // else set null on overflow
+      if (truncatedValue == signedValue)
+        return setInteger(target, truncatedValue);
     } else {
       auto truncatedValue = static_cast<JsonUInt>(unsignedValue);
       if (truncatedValue == unsignedValue)
-        if (!variant->setInteger(truncatedValue, resources_))
-          return DeserializationError::NoMemory;
-      // else set null on overflow
+        return setInteger(target, truncatedValue);
     }
 
+    return setNull(target);  // on overflow
+  }
+
+  template <typename T>
+  DeserializationError::Code setInteger(VariantData* variant, T value) {
+    if (variant->setInteger(value, resources_))
+      return DeserializationError::Ok;
+    else
+      return DeserializationError::NoMemory;
+  }
+
+  DeserializationError::Code setInteger(JsonHandler* handler,
+                                        JsonInteger value) {
+    handler->onInteger(value);
     return DeserializationError::Ok;
   }
 
+  DeserializationError::Code setInteger(JsonHandler* handler, JsonUInt value) {
+    handler->onUnsignedInteger(value);
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code setNull(VariantData*) {
+    return DeserializationError::Ok;  // already null
+  }
+
+  DeserializationError::Code setNull(JsonHandler* handler) {
+    handler->onNull();
+    return DeserializationError::Ok;
+  }
+
+  template <typename T>
+  DeserializationError::Code setFloat(VariantData* variant, T value) {
+    if (variant->setFloat(value, resources_))
+      return DeserializationError::Ok;
+    else
+      return DeserializationError::NoMemory;
+  }
+
   template <typename T>
+  DeserializationError::Code setFloat(JsonHandler* handler, T value) {
+    handler->onFloat(JsonFloat(value));
+    return DeserializationError::Ok;
+  }
+
+  template <typename T, typename TTarget>
   enable_if_t<sizeof(T) == 4, DeserializationError::Code> readFloat(
-      VariantData* variant) {
+      TTarget target) {
     DeserializationError::Code err;
     T value;
 
@@ -257,14 +406,12 @@ class MsgPackDeserializer {
       return err;
 
     fixEndianness(value);
-    variant->setFloat(value, resources_);
-
-    return DeserializationError::Ok;
+    return setFloat(target, value);
   }
 
-  template <typename T>
+  template <typename T, typename TTarget>
   enable_if_t<sizeof(T) == 8, DeserializationError::Code> readDouble(
-      VariantData* variant) {
+      TTarget target) {
     DeserializationError::Code err;
     T value;
 
@@ -273,15 +420,12 @@ class MsgPackDeserializer {
       return err;
 
     fixEndianness(value);
-    if (variant->setFloat(value, resources_))
-      return DeserializationError::Ok;
-    else
-      return DeserializationError::NoMemory;
+    return setFloat(target, value);
   }
 
-  template <typename T>
+  template <typename T, typename TTarget>
   enable_if_t<sizeof(T) == 4, DeserializationError::Code> readDouble(
-      VariantData* variant) {
+      TTarget target) {
     DeserializationError::Code err;
     uint8_t i[8];  // input is 8 bytes
     T value;       // output is 4 bytes
@@ -293,9 +437,7 @@ class MsgPackDeserializer {
 
     doubleToFloat(i, o);
     fixEndianness(value);
-    variant->setFloat(value, resources_);
-
-    return DeserializationError::Ok;
+    return setFloat(target, value);
   }
 
   DeserializationError::Code readString(VariantData* variant, size_t n) {
@@ -320,6 +462,18 @@ class MsgPackDeserializer {
   DeserializationError::Code readRawString(VariantData* variant,
                                            const void* header,
                                            uint8_t headerSize, size_t n) {
+    DeserializationError::Code err;
+
+    err = readRawString(header, headerSize, n);
+    if (err)
+      return err;
+
+    variant->setRawString(stringBuffer_.save());
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code readRawString(const void* header,
+                                           uint8_t headerSize, size_t n) {
     auto totalSize = size_t(headerSize + n);
     if (totalSize < n)                        // integer overflow
       return DeserializationError::NoMemory;  // (not testable on 64-bit)
@@ -330,12 +484,7 @@ class MsgPackDeserializer {
 
     memcpy(p, header, headerSize);
 
-    auto err = readBytes(p + headerSize, n);
-    if (err)
-      return err;
-
-    variant->setRawString(stringBuffer_.save());
-    return DeserializationError::Ok;
+    return readBytes(p + headerSize, n);
   }
 
   template <typename TFilter>
@@ -379,6 +528,26 @@ class MsgPackDeserializer {
     return DeserializationError::Ok;
   }
 
+  DeserializationError::Code readArray(
+      JsonHandler* handler, size_t n,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    handler->onStartArray();
+
+    for (; n; --n) {
+      err = parseVariant(handler, nestingLimit.decrement());
+      if (err)
+        return err;
+    }
+
+    handler->onEndArray();
+    return DeserializationError::Ok;
+  }
+
   template <typename TFilter>
   DeserializationError::Code readObject(
       VariantData* variant, size_t n, TFilter filter,
@@ -426,6 +595,32 @@ class MsgPackDeserializer {
     return DeserializationError::Ok;
   }
 
+  DeserializationError::Code readObject(
+      JsonHandler* handler, size_t n,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    handler->onStartObject();
+
+    for (; n; --n) {
+      err = readKey();
+      if (err)
+        return err;
+
+      handler->onKey(stringBuffer_.str());
+
+      err = parseVariant(handler, nestingLimit.decrement());
+      if (err)
+        return err;
+    }
+
+    handler->onEndObject();
+    return DeserializationError::Ok;
+  }
+
   DeserializationError::Code readKey() {
     DeserializationError::Code err;
     uint8_t code;
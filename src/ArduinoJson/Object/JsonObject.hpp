@@ -130,9 +130,12 @@ class JsonObject : public detail::VariantOperators<JsonObject> {
   }
 
   // Removes the member at the specified iterator.
+  // Returns an iterator to the next member.
   // https://arduinojson.org/v7/api/jsonobject/remove/
-  FORCE_INLINE void remove(iterator it) const {
-    detail::ObjectData::remove(data_, it.iterator_, resources_);
+  FORCE_INLINE iterator remove(iterator it) const {
+    return iterator(
+        detail::ObjectData::remove(data_, it.iterator_, resources_),
+        resources_);
   }
 
   // Removes the member with the specified key.
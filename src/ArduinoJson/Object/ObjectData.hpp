@@ -8,6 +8,8 @@
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
+struct CollectionIndex;
+
 class ObjectData : public CollectionData {
  public:
   template <typename TAdaptedString>  // also works with StringNode*
@@ -39,15 +41,14 @@ class ObjectData : public CollectionData {
     obj->removeMember(key, resources);
   }
 
-  void remove(iterator it, ResourceManager* resources) {
-    CollectionData::removePair(it, resources);
-  }
+  // Returns an iterator to the next member
+  iterator remove(iterator it, ResourceManager* resources);
 
-  static void remove(ObjectData* obj, ObjectData::iterator it,
-                     ResourceManager* resources) {
+  static iterator remove(ObjectData* obj, ObjectData::iterator it,
+                         ResourceManager* resources) {
     if (!obj)
-      return;
-    obj->remove(it, resources);
+      return iterator();
+    return obj->remove(it, resources);
   }
 
   size_t size(const ResourceManager* resources) const {
@@ -60,9 +61,29 @@ class ObjectData : public CollectionData {
     return obj->size(resources);
   }
 
+  // Creates the index of a large object that doesn't have one.
+  // The lookups never create it, so concurrent reads are safe.
+  void buildIndex(ResourceManager* resources);
+
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  // Number of members above which we build the index
+  static const size_t indexThreshold = 16;
+#endif
+
  private:
   template <typename TAdaptedString>
   iterator findKey(TAdaptedString key, const ResourceManager* resources) const;
+
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  template <typename TAdaptedString>
+  iterator findKeyInIndex(const CollectionIndex* index, TAdaptedString key,
+                          const ResourceManager* resources) const;
+  void createIndex(ResourceManager* resources);
+  bool rebuildIndex(CollectionIndex* index, size_t capacity,
+                    ResourceManager* resources);
+  void addToIndex(SlotId keyId, ResourceManager* resources);
+  void removeFromIndex(const VariantData* key, ResourceManager* resources);
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -34,13 +34,20 @@ inline ObjectData::iterator ObjectData::findKey(
     TAdaptedString key, const ResourceManager* resources) const {
   if (key.isNull())
     return iterator();
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  auto index = resources->getCollectionIndex(head());
+  if (index)
+    return findKeyInIndex(index, key, resources);
+#endif
   bool isKey = true;
-  for (auto it = createIterator(resources); !it.done(); it.next(resources)) {
+  auto it = createIterator(resources);
+  while (!it.done()) {
     if (isKey && stringEquals(key, adaptString(it->asString())))
-      return it;
+      break;
     isKey = !isKey;
+    it.next(resources);
   }
-  return iterator();
+  return it;
 }
 
 template <typename TAdaptedString>
@@ -49,6 +56,15 @@ inline void ObjectData::removeMember(TAdaptedString key,
   remove(findKey(key, resources), resources);
 }
 
+inline ObjectData::iterator ObjectData::remove(iterator it,
+                                               ResourceManager* resources) {
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  if (!it.done())
+    removeFromIndex(it.data(), resources);
+#endif
+  return CollectionData::removePair(it, resources);
+}
+
 template <typename TAdaptedString>
 inline VariantData* ObjectData::addMember(TAdaptedString key,
                                           ResourceManager* resources) {
@@ -65,9 +81,135 @@ inline VariantData* ObjectData::addMember(TAdaptedString key,
 
   CollectionData::appendPair(keySlot, valueSlot, resources);
 
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  addToIndex(keySlot.id(), resources);
+#endif
+
   return valueSlot.ptr();
 }
 
+inline void ObjectData::buildIndex(ResourceManager* resources) {
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  if (size(resources) > indexThreshold &&
+      !resources->getCollectionIndex(head()))
+    createIndex(resources);
+#else
+  (void)resources;
+#endif
+}
+
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+// The index is an open-addressing hash table of key slots, with linear probing.
+// Its capacity is a power of two, and it's never more than half full.
+
+inline size_t hashKey(const VariantData* key) {
+  return stringHash(adaptString(key->asString()));
+}
+
+template <typename TAdaptedString>
+inline ObjectData::iterator ObjectData::findKeyInIndex(
+    const CollectionIndex* index, TAdaptedString key,
+    const ResourceManager* resources) const {
+  auto mask = index->capacity - 1;
+  for (auto i = stringHash(key) & mask; index->slots[i] != NULL_SLOT;
+       i = (i + 1) & mask) {
+    auto keySlot = resources->getVariant(index->slots[i]);
+    // the index doesn't know the previous slot, so removeMember() still walks
+    // the list; only remove(iterator) runs in constant time
+    if (stringEquals(key, adaptString(keySlot->asString())))
+      return createIterator(index->slots[i], NULL_SLOT, resources);
+  }
+  return iterator();
+}
+
+inline void ObjectData::createIndex(ResourceManager* resources) {
+  auto index = resources->createCollectionIndex(head());
+  if (!index)
+    return;
+  size_t capacity = indexThreshold * 4;
+  while (capacity < size(resources) * 2 + 2)
+    capacity *= 2;
+  if (!rebuildIndex(index, capacity, resources))
+    resources->destroyCollectionIndex(head());
+}
+
+inline bool ObjectData::rebuildIndex(CollectionIndex* index, size_t capacity,
+                                     ResourceManager* resources) {
+  if (!resources->resizeCollectionIndex(index, capacity))
+    return false;
+  auto mask = capacity - 1;
+  for (size_t i = 0; i < capacity; i++)
+    index->slots[i] = NULL_SLOT;
+  index->count = 0;
+  bool isKey = true;
+  for (auto it = createIterator(resources); !it.done(); it.next(resources)) {
+    if (isKey) {
+      auto i = hashKey(it.data()) & mask;
+      while (index->slots[i] != NULL_SLOT)
+        i = (i + 1) & mask;
+      index->slots[i] = it.id();
+      index->count++;
+    }
+    isKey = !isKey;
+  }
+  return true;
+}
+
+inline void ObjectData::addToIndex(SlotId keyId, ResourceManager* resources) {
+  auto index = resources->getCollectionIndex(head());
+  if (!index) {
+    // build the index when the object crosses the threshold
+    const size_t slotCount = indexThreshold * 2 + 2;
+    if (countSlots(slotCount + 1, resources) == slotCount)
+      createIndex(resources);
+    return;
+  }
+
+  if ((index->count + 1) * 2 > index->capacity) {
+    // the key is already in the collection, so rebuilding adds it
+    if (!rebuildIndex(index, index->capacity * 2, resources))
+      resources->destroyCollectionIndex(head());
+    return;
+  }
+
+  auto mask = index->capacity - 1;
+  auto i = hashKey(resources->getVariant(keyId)) & mask;
+  while (index->slots[i] != NULL_SLOT)
+    i = (i + 1) & mask;
+  index->slots[i] = keyId;
+  index->count++;
+}
+
+inline void ObjectData::removeFromIndex(
+    const VariantData* key, ResourceManager* resources) {
+  auto index = resources->getCollectionIndex(head());
+  if (!index)
+    return;
+
+  auto mask = index->capacity - 1;
+  auto hole = hashKey(key) & mask;
+  while (resources->getVariant(index->slots[hole]) != key) {
+    if (index->slots[hole] == NULL_SLOT)
+      return;
+    hole = (hole + 1) & mask;
+  }
+
+  // Backward-shift deletion, see StringPool::removeFromIndex()
+  for (auto i = (hole + 1) & mask; index->slots[i] != NULL_SLOT;
+       i = (i + 1) & mask) {
+    auto home = hashKey(resources->getVariant(index->slots[i])) & mask;
+    bool canMove =
+        hole < i ? (home <= hole || home > i) : (home <= hole && home > i);
+    if (canMove) {
+      index->slots[hole] = index->slots[i];
+      hole = i;
+    }
+  }
+  index->slots[hole] = NULL_SLOT;
+  index->count--;
+}
+#endif
+
 // Returns the size (in bytes) of an object with n members.
 constexpr size_t sizeofObject(size_t n) {
   return 2 * n * ResourceManager::slotSize;
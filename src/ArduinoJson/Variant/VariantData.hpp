@@ -559,6 +559,10 @@ class VariantData {
       return;
     var->clear(resources);
   }
+
+  // Updates the slot ids and the strings of a variant that was moved by
+  // ResourceManager::merge(), and rebuilds the indexes of its collections.
+  void rebase(SlotId offset, ResourceManager* resources);
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
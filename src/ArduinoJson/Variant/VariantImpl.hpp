@@ -56,6 +56,27 @@ inline void VariantData::clear(ResourceManager* resources) {
   type_ = VariantType::Null;
 }
 
+inline void VariantData::rebase(SlotId offset, ResourceManager* resources) {
+  if (type_ & VariantTypeBits::OwnedStringBit)
+    content_.asOwnedString = resources->adoptString(content_.asOwnedString);
+
+#if ARDUINOJSON_USE_EXTENSIONS
+  if (type_ & VariantTypeBits::ExtensionBit)
+    content_.asSlotId = SlotId(content_.asSlotId + offset);
+#endif
+
+  auto collection = asCollection();
+  if (!collection)
+    return;
+  collection->rebase(offset, resources);
+  auto array = asArray();
+  if (array)
+    array->buildIndex(resources);
+  auto object = asObject();
+  if (object)
+    object->buildIndex(resources);
+}
+
 #if ARDUINOJSON_USE_EXTENSIONS
 inline const VariantExtension* VariantData::getExtension(
     const ResourceManager* resources) const {